@@ -0,0 +1,236 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Headless host simulator benchmark for the B.Angr DSP. Runs the plugin
+ * in-process over a matrix of sample rates, block sizes, flexibility types,
+ * Nuke settings and cursor motion modes and reports the processing time per
+ * sample, the real-time factor and the per-block timing distribution.
+ *
+ * Usage: bangr-bench [--quick] [--seconds S] [--json]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include "OfflineHost.hpp"
+#include "Percentile.hpp"
+#include "Ports.hpp"
+
+enum CursorMotion
+{
+	MOTION_STATIC	= 0,	// No automatic cursor movement
+	MOTION_MOVING	= 1,	// Cursor moved by speed and spin
+	MOTION_DRAGGED	= 2,	// Cursor dragged from the GUI each block
+	NR_MOTIONS	= 3
+};
+
+const char* flexNames[NR_FLEX] = {"random", "level", "lows", "mids", "highs"};
+const char* motionNames[NR_MOTIONS] = {"static", "moving", "dragged"};
+
+struct BenchConfig
+{
+	double rate;
+	uint32_t block;
+	int flex;
+	float nuke;
+	int motion;
+};
+
+struct BenchResult
+{
+	BenchConfig config;
+	double nsPerSample;
+	double rtf;
+	double p50;
+	double p90;
+	double p99;
+	double max;
+};
+
+/**
+Creates a deterministic stereo test signal: pink-ish noise plus decaying
+sine bursts to feed the level and band followers.
+ */
+static void createSignal (std::vector<float>& left, std::vector<float>& right, const double rate)
+{
+	uint32_t seed = 0x12345678u;
+	float b0 = 0.0f;
+	float b1 = 0.0f;
+	for (size_t i = 0; i < left.size(); ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		const float white = (float (seed >> 8) / 8388608.0f) - 1.0f;
+		b0 = 0.99765f * b0 + white * 0.0990460f;
+		b1 = 0.96300f * b1 + white * 0.2965164f;
+		const double t = double (i) / rate;
+		const double burst = fmod (t, 0.5);
+		const float sine = 0.5f * exp (-8.0 * burst) * sin (2.0 * M_PI * (110.0 + 880.0 * fmod (t, 2.0)) * t);
+		left[i] = 0.5f * (b0 + b1) + sine;
+		right[i] = 0.5f * (b0 - b1) + sine;
+	}
+}
+
+static BenchResult runBench (const BenchConfig& config, const double seconds)
+{
+	const uint32_t nframes = std::max<uint32_t> (config.block, uint32_t (seconds * config.rate));
+	const uint32_t nblocks = nframes / config.block;
+
+	std::vector<float> inL (nframes);
+	std::vector<float> inR (nframes);
+	std::vector<float> outL (config.block);
+	std::vector<float> outR (config.block);
+	std::vector<double> blockTimes (nblocks);
+	createSignal (inL, inR, config.rate);
+
+	OfflineHost host (config.rate);
+	host.controllers[SPEED_TYPE] = config.flex;
+	host.controllers[SPIN_TYPE] = config.flex;
+	host.controllers[SPEED] = (config.motion == MOTION_MOVING ? 1.0f : 0.0f);
+	host.controllers[SPIN] = (config.motion == MOTION_MOVING ? 0.5f : 0.0f);
+	host.controllers[SPEED_RANGE] = (config.motion == MOTION_MOVING ? 0.25f : 0.0f);
+	host.controllers[SPIN_RANGE] = (config.motion == MOTION_MOVING ? 0.1f : 0.0f);
+	for (int i = 0; i < NR_FX; ++i) host.controllers[FX + i * NR_PARAMS + PARAM_NUKE] = config.nuke;
+	host.sendMessage (0, host.getURIs().bangr_uiOn);
+
+	double total = 0.0;
+	for (uint32_t b = 0; b < nblocks; ++b)
+	{
+		if (config.motion == MOTION_DRAGGED)
+		{
+			const float phase = 2.0 * M_PI * double (b * config.block) / config.rate;
+			host.sendCursor (0, 0.5f + 0.4f * cos (phase), 0.5f + 0.4f * sin (phase), true);
+		}
+
+		const uint32_t offset = b * config.block;
+		const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		host.run (&inL[offset], &inR[offset], outL.data(), outR.data(), config.block);
+		const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+		const double ns = std::chrono::duration<double, std::nano> (t1 - t0).count();
+		blockTimes[b] = ns / config.block;
+		total += ns;
+	}
+
+	BenchResult result;
+	result.config = config;
+	result.nsPerSample = total / (double (nblocks) * config.block);
+	result.rtf = (total > 0.0 ? (double (nblocks) * config.block / config.rate) / (total * 1e-9) : 0.0);
+	result.p50 = percentile (blockTimes, 0.5);
+	result.p90 = percentile (blockTimes, 0.9);
+	result.p99 = percentile (blockTimes, 0.99);
+	result.max = (blockTimes.empty() ? 0.0 : *std::max_element (blockTimes.begin(), blockTimes.end()));
+	return result;
+}
+
+static void printUsage ()
+{
+	fprintf
+	(
+		stderr,
+		"Usage: bangr-bench [OPTIONS]\n"
+		"  --quick       Reduced test matrix\n"
+		"  --seconds S   Audio duration per configuration (default 2)\n"
+		"  --json        Machine-readable output\n"
+		"  --help        Show this help\n"
+	);
+}
+
+int main (int argc, char** argv)
+{
+	bool quick = false;
+	bool json = false;
+	double seconds = 2.0;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if (strcmp (argv[i], "--quick") == 0) quick = true;
+		else if (strcmp (argv[i], "--json") == 0) json = true;
+		else if ((strcmp (argv[i], "--seconds") == 0) && (i + 1 < argc)) seconds = atof (argv[++i]);
+		else
+		{
+			printUsage();
+			return (strcmp (argv[i], "--help") == 0 ? 0 : 1);
+		}
+	}
+
+	if (!(seconds > 0.0))
+	{
+		fprintf (stderr, "Invalid duration.\n");
+		return 1;
+	}
+
+	const std::vector<double> rates = (quick ? std::vector<double> {48000.0} : std::vector<double> {44100.0, 48000.0, 88200.0, 96000.0, 192000.0});
+	const std::vector<uint32_t> blocks = (quick ? std::vector<uint32_t> {64, 1024} : std::vector<uint32_t> {16, 64, 256, 1024, 8192});
+	const std::vector<int> flexes = (quick ? std::vector<int> {RANDOM, LOWS} : std::vector<int> {RANDOM, LEVEL, LOWS, MIDS, HIGHS});
+	const std::vector<float> nukes = (quick ? std::vector<float> {0.0f, 1.0f} : std::vector<float> {0.0f, 0.5f, 1.0f});
+
+	if (json) printf ("[\n");
+	else printf ("%8s %6s %-7s %5s %-8s %10s %9s %10s %10s %10s %10s\n", "rate", "block", "flex", "nuke", "cursor", "ns/sample", "RTF", "p50", "p90", "p99", "max");
+
+	bool first = true;
+	for (double rate : rates)
+	{
+		for (uint32_t block : blocks)
+		{
+			for (int flex : flexes)
+			{
+				for (float nuke : nukes)
+				{
+					for (int motion = 0; motion < NR_MOTIONS; ++motion)
+					{
+						const BenchResult r = runBench (BenchConfig {rate, block, flex, nuke, motion}, seconds);
+
+						if (json)
+						{
+							printf
+							(
+								"%s  {\"rate\": %.0f, \"block\": %u, \"flex\": \"%s\", \"nuke\": %.2f, \"cursor\": \"%s\", "
+								"\"ns_per_sample\": %.3f, \"rtf\": %.2f, \"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}",
+								(first ? "" : ",\n"), rate, block, flexNames[flex], nuke, motionNames[motion],
+								r.nsPerSample, r.rtf, r.p50, r.p90, r.p99, r.max
+							);
+						}
+						else
+						{
+							printf
+							(
+								"%8.0f %6u %-7s %5.2f %-8s %10.3f %9.2f %10.3f %10.3f %10.3f %10.3f\n",
+								rate, block, flexNames[flex], nuke, motionNames[motion],
+								r.nsPerSample, r.rtf, r.p50, r.p90, r.p99, r.max
+							);
+						}
+						fflush (stdout);
+						first = false;
+					}
+				}
+			}
+		}
+	}
+
+	if (json) printf ("\n]\n");
+	else printf ("(p50 ... max: per-block ns/sample)\n");
+	return 0;
+}
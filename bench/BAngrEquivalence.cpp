@@ -0,0 +1,518 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Numerical equivalence check of the XRegion and Butterworth filter
+ * implementations and of the complete engine against the frozen reference
+ * copies in bench/reference/. Both paths are fed with sweeps, noise,
+ * impulses and optionally programme material (raw 32 bit float,
+ * interleaved stereo). XRegion runs with static parameters and with
+ * parameters modulated per block and per sample, the engine runs with the
+ * moving cursor. Reports the maximum
+ * absolute error, the RMS error and the maximum deviation of the averaged
+ * power spectra.
+ *
+ * Usage: bangr-equivalence [--rate R] [--input FILE] [--max-abs A] [--max-rms R] [--max-spectral DB]
+ * Returns 1 if any case exceeds the bounds.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <vector>
+#include "Airwindows/XRegion.hpp"
+#include "BAngrEngine.hpp"
+#include "ButterworthLowPassFilter.hpp"
+#include "ButterworthHighPassFilter.hpp"
+#include "ButterworthBandPassFilter.hpp"
+#include "Blend.hpp"
+#include "Checkpoint.hpp"
+#include "ControllerLimits.hpp"
+#include "Ports.hpp"
+#include "reference/XRegionReference.hpp"
+#include "reference/BAngrReference.hpp"
+#include "reference/ButterworthReference.hpp"
+
+#define EQ_BLOCK 256
+#define EQ_FFT_SIZE 4096
+#define EQ_SPECTRAL_FLOOR 1e-8		// -80 dB relative to the spectral peak
+#define EQ_MOD_PERIOD 64		// Parameter updates per modulation cycle
+#define EQ_MOD_HOLD 3			// Updates with identical parameters
+#define EQ_MOD_DEPTH 0.4		// Modulation radius around the pad position
+#define EQ_SEED 0x42616e67ULL
+
+enum Modulation
+{
+	MOD_STATIC,
+	MOD_BLOCK,
+	MOD_SAMPLE,
+	NR_MODULATIONS
+};
+
+const char* modulationNames[NR_MODULATIONS] = {"", ",block", ",sample"};
+
+/*
+ * XRegion case: Pad position (blended FX parameters), optionally with
+ * full Nuke, and parameter modulation.
+ */
+struct XRegionCase
+{
+	std::string name;
+	float x;
+	float y;
+	bool nuke;
+	Modulation modulation;
+};
+
+/*
+ * Engine case: Flexibility types of speed and spin.
+ */
+struct EngineCase
+{
+	std::string name;
+	int speedType;
+	int spinType;
+};
+
+struct Signal
+{
+	std::string name;
+	std::vector<float> left;
+	std::vector<float> right;
+};
+
+struct Deviation
+{
+	double maxAbs;
+	double rms;
+	double spectral;
+};
+
+struct Bounds
+{
+	double maxAbs;
+	double rms;
+	double spectral;
+};
+
+static void fft (std::vector<std::complex<double>>& x)
+{
+	const size_t n = x.size();
+	for (size_t i = 1, j = 0; i < n; ++i)
+	{
+		size_t bit = n >> 1;
+		for (; j & bit; bit >>= 1) j ^= bit;
+		j ^= bit;
+		if (i < j) std::swap (x[i], x[j]);
+	}
+
+	for (size_t len = 2; len <= n; len <<= 1)
+	{
+		const std::complex<double> wlen = std::polar (1.0, -2.0 * M_PI / double (len));
+		for (size_t i = 0; i < n; i += len)
+		{
+			std::complex<double> w (1.0, 0.0);
+			for (size_t j = 0; j < len / 2; ++j)
+			{
+				const std::complex<double> u = x[i + j];
+				const std::complex<double> v = x[i + j + len / 2] * w;
+				x[i + j] = u + v;
+				x[i + j + len / 2] = u - v;
+				w *= wlen;
+			}
+		}
+	}
+}
+
+/**
+Calculates the averaged power spectrum using Hann windowed frames with 50%
+overlap.
+ */
+static std::vector<double> powerSpectrum (const std::vector<float>& signal)
+{
+	std::vector<double> power (EQ_FFT_SIZE / 2 + 1, 0.0);
+	std::vector<std::complex<double>> frame (EQ_FFT_SIZE);
+
+	for (size_t pos = 0; pos + EQ_FFT_SIZE <= signal.size(); pos += EQ_FFT_SIZE / 2)
+	{
+		for (int i = 0; i < EQ_FFT_SIZE; ++i)
+		{
+			const double w = 0.5 - 0.5 * cos (2.0 * M_PI * double (i) / double (EQ_FFT_SIZE));
+			frame[i] = std::complex<double> (w * signal[pos + i], 0.0);
+		}
+		fft (frame);
+		for (size_t i = 0; i < power.size(); ++i) power[i] += std::norm (frame[i]);
+	}
+	return power;
+}
+
+static Deviation compare (const std::vector<float>& reference, const std::vector<float>& test)
+{
+	Deviation d {0.0, 0.0, 0.0};
+	const size_t n = std::min (reference.size(), test.size());
+	if (n == 0) return d;
+
+	double sum = 0.0;
+	for (size_t i = 0; i < n; ++i)
+	{
+		const double e = double (test[i]) - double (reference[i]);
+		if (!std::isfinite (e)) return Deviation {HUGE_VAL, HUGE_VAL, HUGE_VAL};
+		d.maxAbs = std::max (d.maxAbs, fabs (e));
+		sum += e * e;
+	}
+	d.rms = sqrt (sum / n);
+
+	const std::vector<double> pr = powerSpectrum (reference);
+	const std::vector<double> pt = powerSpectrum (test);
+	const double peak = *std::max_element (pr.begin(), pr.end());
+	for (size_t i = 0; i < pr.size(); ++i)
+	{
+		if ((peak > 0.0) && (pr[i] > peak * EQ_SPECTRAL_FLOOR))
+		{
+			const double db = 10.0 * log10 (std::max (pt[i], 1e-300) / pr[i]);
+			d.spectral = std::max (d.spectral, fabs (db));
+		}
+	}
+	return d;
+}
+
+static Signal createSweep (const double rate, const size_t n)
+{
+	Signal s {"sweep", std::vector<float> (n), std::vector<float> (n)};
+	const double f0 = 20.0;
+	const double f1 = std::min (20000.0, 0.45 * rate);
+	const double t1 = double (n) / rate;
+	const double k = log (f1 / f0);
+	for (size_t i = 0; i < n; ++i)
+	{
+		const double t = double (i) / rate;
+		const double phase = 2.0 * M_PI * f0 * t1 / k * (exp (t / t1 * k) - 1.0);
+		s.left[i] = 0.8 * sin (phase);
+		s.right[i] = 0.8 * cos (phase);
+	}
+	return s;
+}
+
+static Signal createNoise (const size_t n)
+{
+	Signal s {"noise", std::vector<float> (n), std::vector<float> (n)};
+	uint32_t seed = 0x2468aceu;
+	for (size_t i = 0; i < n; ++i)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		s.left[i] = 0.5f * ((float (seed >> 8) / 8388608.0f) - 1.0f);
+		seed = seed * 1664525u + 1013904223u;
+		s.right[i] = 0.5f * ((float (seed >> 8) / 8388608.0f) - 1.0f);
+	}
+	return s;
+}
+
+static Signal createImpulses (const double rate, const size_t n)
+{
+	Signal s {"impulses", std::vector<float> (n, 0.0f), std::vector<float> (n, 0.0f)};
+	const size_t distance = std::max<size_t> (1, rate / 10.0);
+	for (size_t i = 0; i < n; i += distance)
+	{
+		s.left[i] = 1.0f;
+		s.right[(i + distance / 2) % n] = -1.0f;
+	}
+	return s;
+}
+
+static bool loadSignal (const char* filename, Signal& s)
+{
+	FILE* file = fopen (filename, "rb");
+	if (!file) return false;
+
+	s.name = "input";
+	float frame[2];
+	while (fread (frame, sizeof (float), 2, file) == 2)
+	{
+		s.left.push_back (frame[0]);
+		s.right.push_back (frame[1]);
+	}
+	fclose (file);
+	return !s.left.empty();
+}
+
+/**
+Calculates the XRegion parameters for the provided update step. Modulated
+cases circle around the pad position and hold each position for
+EQ_MOD_HOLD updates, thus identical parameters are set, too.
+ */
+static void getParams (const XRegionCase& c, const float* fx, const size_t step, float* params)
+{
+	float x = c.x;
+	float y = c.y;
+	if (c.modulation != MOD_STATIC)
+	{
+		const double phase = 2.0 * M_PI * double (step / EQ_MOD_HOLD) / EQ_MOD_PERIOD;
+		x = std::min (std::max (c.x + EQ_MOD_DEPTH * sin (phase), 0.0), 1.0);
+		y = std::min (std::max (c.y + EQ_MOD_DEPTH * cos (phase), 0.0), 1.0);
+	}
+	blendParams (x, y, fx, params);
+	if (c.nuke) params[PARAM_NUKE] = 1.0f;
+}
+
+/**
+Processes a signal with an XRegion (or its reference). Parameters are set
+once (static), before each block or before each sample.
+ */
+template <class DSP>
+static void processXRegion (DSP& dsp, const XRegionCase& c, const float* fx, const Signal& s, std::vector<float>& out)
+{
+	const size_t n = s.left.size();
+	std::vector<float> in1 (s.left);
+	std::vector<float> in2 (s.right);
+	std::vector<float> out1 (n);
+	std::vector<float> out2 (n);
+	const size_t stride = (c.modulation == MOD_SAMPLE ? 1 : EQ_BLOCK);
+	float params[NR_PARAMS];
+
+	for (size_t i = 0, step = 0; i < n; i += stride, ++step)
+	{
+		if ((step == 0) || (c.modulation != MOD_STATIC))
+		{
+			getParams (c, fx, step, params);
+			dsp.setParameters (params);
+		}
+		const int32_t nframes = std::min<size_t> (stride, n - i);
+		dsp.process (&in1[i], &in2[i], &out1[i], &out2[i], nframes);
+	}
+
+	out.resize (2 * n);
+	for (size_t i = 0; i < n; ++i) {out[i] = out1[i]; out[n + i] = out2[i];}
+}
+
+/**
+Runs the XRegion and its reference with the same DSP state and parameters.
+ */
+static void runXRegion (const double rate, const XRegionCase& c, const float* fx, const Signal& s, std::vector<float>& ref, std::vector<float>& test)
+{
+	XRegion xregion (rate);
+	XRegionReference reference (rate);
+
+	// Share dither and history state
+	std::vector<uint8_t> snapshot;
+	CheckpointWriter size;
+	xregion.writeCheckpoint (size);
+	snapshot.resize (size.getPosition());
+	CheckpointWriter writer (snapshot.data(), snapshot.size());
+	xregion.writeCheckpoint (writer);
+	CheckpointReader reader (snapshot.data(), snapshot.size());
+	reference.readCheckpoint (reader);
+
+	processXRegion (reference, c, fx, s, ref);
+	processXRegion (xregion, c, fx, s, test);
+}
+
+/**
+Runs the engine and the reference of the original DSP with the same seed
+and controllers. The cursor moves with the engine physics. Not inlined to
+keep the code generation of the other checks independent from the engine
+runs (-ffast-math).
+ */
+__attribute__ ((noinline)) static void runEngine (const double rate, const EngineCase& c, const Signal& s, std::vector<float>& ref, std::vector<float>& test)
+{
+	const size_t n = s.left.size();
+	std::vector<float> out1 (n);
+	std::vector<float> out2 (n);
+
+	BAngrEngine engine (rate, EQ_BLOCK);
+	BAngrReference reference (rate);
+	engine.seed (EQ_SEED);
+	reference.seed (EQ_SEED);
+
+	float controllers[NR_CONTROLLERS];
+	std::copy (controllerDefaults, controllerDefaults + NR_CONTROLLERS, controllers);
+	controllers[SPEED] = 0.9f;
+	controllers[SPEED_TYPE] = c.speedType;
+	controllers[SPIN] = 0.3f;
+	controllers[SPIN_RANGE] = 0.5f;
+	controllers[SPIN_TYPE] = c.spinType;
+	for (int i = 0; i < NR_CONTROLLERS; ++i)
+	{
+		engine.setController (i, controllers[i]);
+		reference.setController (i, controllers[i]);
+	}
+
+	for (size_t i = 0; i < n; i += EQ_BLOCK)
+	{
+		const uint32_t nframes = std::min<size_t> (EQ_BLOCK, n - i);
+		reference.process (&s.left[i], &s.right[i], &out1[i], &out2[i], nframes);
+	}
+	ref.resize (2 * n);
+	for (size_t i = 0; i < n; ++i) {ref[i] = out1[i]; ref[n + i] = out2[i];}
+
+	for (size_t i = 0; i < n; i += EQ_BLOCK)
+	{
+		const uint32_t nframes = std::min<size_t> (EQ_BLOCK, n - i);
+		engine.process (&s.left[i], &s.right[i], &out1[i], &out2[i], nframes);
+	}
+	test.resize (2 * n);
+	for (size_t i = 0; i < n; ++i) {test[i] = out1[i]; test[n + i] = out2[i];}
+}
+
+template <class Filter, class Reference>
+static void runFilter (Filter& filter, Reference& reference, const Signal& s, std::vector<float>& ref, std::vector<float>& test)
+{
+	const size_t n = s.left.size();
+	ref.resize (n);
+	test.resize (n);
+	for (size_t i = 0; i < n; ++i) ref[i] = reference.process (s.left[i]);
+	for (size_t i = 0; i < n; ++i) test[i] = filter.process (s.left[i]);
+}
+
+static void printUsage ()
+{
+	fprintf
+	(
+		stderr,
+		"Usage: bangr-equivalence [OPTIONS]\n"
+		"  --rate R            Sample rate (default 48000)\n"
+		"  --seconds S         Duration of the generated signals (default 4)\n"
+		"  --input FILE        Additional programme material, raw float32 interleaved stereo\n"
+		"  --max-abs A         Bound for the maximum absolute error (default 1e-3)\n"
+		"  --max-rms R         Bound for the RMS error (default 1e-4)\n"
+		"  --max-spectral DB   Bound for the spectral deviation in dB (default 0.1)\n"
+		"  --help              Show this help\n"
+	);
+}
+
+int main (int argc, char** argv)
+{
+	double rate = 48000.0;
+	double seconds = 4.0;
+	const char* inputFile = nullptr;
+	Bounds bounds {1e-3, 1e-4, 0.1};
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if ((strcmp (argv[i], "--rate") == 0) && (i + 1 < argc)) rate = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--seconds") == 0) && (i + 1 < argc)) seconds = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--input") == 0) && (i + 1 < argc)) inputFile = argv[++i];
+		else if ((strcmp (argv[i], "--max-abs") == 0) && (i + 1 < argc)) bounds.maxAbs = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--max-rms") == 0) && (i + 1 < argc)) bounds.rms = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--max-spectral") == 0) && (i + 1 < argc)) bounds.spectral = atof (argv[++i]);
+		else
+		{
+			printUsage();
+			return (strcmp (argv[i], "--help") == 0 ? 0 : 1);
+		}
+	}
+
+	if (!(rate >= 8000.0) || !(seconds > 0.0))
+	{
+		printUsage();
+		return 1;
+	}
+
+	const size_t n = rate * seconds;
+	std::vector<Signal> signals = {createSweep (rate, n), createNoise (n), createImpulses (rate, n)};
+	if (inputFile)
+	{
+		Signal s;
+		if (!loadSignal (inputFile, s))
+		{
+			fprintf (stderr, "Can't read input file %s.\n", inputFile);
+			return 1;
+		}
+		signals.push_back (s);
+	}
+
+	// XRegion cases: Default pad corners and center, each with and without
+	// full Nuke. Modulated around the center per block and per sample.
+	float fx[NR_FX * NR_PARAMS];
+	for (int i = 0; i < NR_FX * NR_PARAMS; ++i) fx[i] = controllerDefaults[FX + i];
+	const float positions[][2] = {{0.0f, 0.0f}, {0.0f, 1.0f}, {1.0f, 1.0f}, {1.0f, 0.0f}, {0.5f, 0.5f}};
+	std::vector<XRegionCase> xregionCases;
+	for (int m = MOD_STATIC; m < NR_MODULATIONS; ++m)
+	{
+		for (int nuke = 0; nuke < 2; ++nuke)
+		{
+			for (const float* p : positions)
+			{
+				if ((m != MOD_STATIC) && ((p[0] != 0.5f) || (p[1] != 0.5f))) continue;
+				char name[64];
+				snprintf (name, sizeof (name), "xregion(%.1f,%.1f%s%s)", p[0], p[1], (nuke ? ",nuke" : ""), modulationNames[m]);
+				xregionCases.push_back (XRegionCase {name, p[0], p[1], bool (nuke), Modulation (m)});
+			}
+		}
+	}
+
+	const std::vector<EngineCase> engineCases = {{"engine(random)", RANDOM, RANDOM}, {"engine(lows,mids)", LOWS, MIDS}};
+
+	bool failed = false;
+	printf ("%-28s %-9s %12s %12s %12s\n", "case", "signal", "max abs", "rms", "spectral dB");
+
+	const std::function<void (const std::string&, const std::string&, const Deviation&)> report =
+	[&] (const std::string& name, const std::string& signal, const Deviation& d)
+	{
+		const bool fail = (d.maxAbs > bounds.maxAbs) || (d.rms > bounds.rms) || (d.spectral > bounds.spectral);
+		printf ("%-28s %-9s %12.3e %12.3e %12.4f %s\n", name.c_str(), signal.c_str(), d.maxAbs, d.rms, d.spectral, (fail ? "FAIL" : "ok"));
+		failed = failed || fail;
+	};
+
+	std::vector<float> ref;
+	std::vector<float> test;
+	for (const Signal& s : signals)
+	{
+		for (const XRegionCase& c : xregionCases)
+		{
+			runXRegion (rate, c, fx, s, ref, test);
+			report (c.name, s.name, compare (ref, test));
+		}
+
+		for (const EngineCase& c : engineCases)
+		{
+			runEngine (rate, c, s, ref, test);
+			report (c.name, s.name, compare (ref, test));
+		}
+
+		ButterworthLowPassFilter lowpass (rate, 200.0, 8);
+		ButterworthLowPassFilterReference lowpassRef (rate, 200.0, 8);
+		runFilter (lowpass, lowpassRef, s, ref, test);
+		report ("butterworth_lowpass", s.name, compare (ref, test));
+
+		ButterworthHighPassFilter highpass (rate, 4000.0, 8);
+		ButterworthHighPassFilterReference highpassRef (rate, 4000.0, 8);
+		runFilter (highpass, highpassRef, s, ref, test);
+		report ("butterworth_highpass", s.name, compare (ref, test));
+
+		ButterworthBandPassFilter bandpass (rate, 200.0, 4000.0, 8);
+		ButterworthBandPassFilterReference bandpassRef (rate, 200.0, 4000.0, 8);
+		runFilter (bandpass, bandpassRef, s, ref, test);
+		report ("butterworth_bandpass", s.name, compare (ref, test));
+	}
+
+	if (failed)
+	{
+		fprintf (stderr, "Deviation beyond bounds (max abs %g, rms %g, spectral %g dB).\n", bounds.maxAbs, bounds.rms, bounds.spectral);
+		return 1;
+	}
+
+	return 0;
+}
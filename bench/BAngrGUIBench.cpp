@@ -0,0 +1,538 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+/*
+ * Headless render benchmark for the B.Angr GUI. Builds the widget tree of
+ * the GUI (the BAngrWidgets tree of BAngrGUI with probed widgets) without
+ * a window and thus without X11 and renders scripted activity into an
+ * offscreen cairo image surface: cursor motion with trail, controller
+ * automation, zoom changes and preset loads. Each widget draw is recorded
+ * and the damaged areas are composited into the offscreen surface as the
+ * window would do. Reports the frame time percentiles and the number of
+ * (device) pixels repainted per frame.
+ *
+ * With --startup, the editor open latency is measured instead: shared
+ * resources, widget construction, theme and first frame for the first
+ * (cold) and for repeated opens after closing.
+ *
+ * Usage: bangr-guibench [--frames N] [--seed N] [--zoom Z] [--bundle PATH] [--scenario NAME]
+ *        bangr-guibench --startup N [--zoom Z] [--bundle PATH]
+ */
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cairo/cairo.h>
+#include "BWidgets/BWidgets/Widget.hpp"
+#include "BAngrResources.hpp"
+#include "BAngrWidgets.hpp"
+#include "ControllerLimits.hpp"
+#include "CursorMessage.hpp"
+#include "Definitions.hpp"
+#include "Percentile.hpp"
+#include "Ports.hpp"
+#include "RTRand.hpp"
+
+#define GUIBENCH_WIDTH 1000.0
+#define GUIBENCH_HEIGHT 560.0
+#define GUIBENCH_FRAME_RATE 60.0
+
+enum GuiScenario
+{
+	GUI_IDLE,
+	GUI_CURSOR,
+	GUI_AUTOMATION,
+	GUI_ZOOM,
+	GUI_PRESET,
+	GUI_MIXED,
+	NR_GUI_SCENARIOS
+};
+
+const char* scenarioNames[NR_GUI_SCENARIOS] = {"idle", "cursor", "automation", "zoom", "preset", "mixed"};
+
+struct Damage
+{
+	double x, y, width, height;
+};
+
+/*
+ * Damage collected by the probed widgets in a frame (absolute widget
+ * coordinates) and the time spent in their draw calls.
+ */
+static std::vector<Damage> damages;
+static double drawNs = 0.0;
+
+/*
+ * Widget probe: Forwards to the widget draw and records the drawn area.
+ * Each probe knows the absolute position of its parent.
+ */
+template <class W>
+class Probe : public W
+{
+public:
+	using W::W;
+
+	double parentX = 0.0;
+	double parentY = 0.0;
+
+	double getAbsoluteX () const {return parentX + this->getPosition().x;}
+	double getAbsoluteY () const {return parentY + this->getPosition().y;}
+
+protected:
+	using W::draw;
+
+	virtual void draw (const BUtilities::Area<>& area) override
+	{
+		const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		W::draw (area);
+		drawNs += std::chrono::duration<double, std::nano> (std::chrono::steady_clock::now() - t0).count();
+		damages.push_back (Damage {getAbsoluteX() + area.getX(), getAbsoluteY() + area.getY(), area.getWidth(), area.getHeight()});
+	}
+};
+
+/*
+ * Compositing entry in window z-order with the absolute widget position.
+ * Moving widgets (cursor) take their position from the widget.
+ */
+struct Layer
+{
+	BWidgets::Widget* widget;
+	double x;
+	double y;
+	bool moving = false;
+};
+
+/*
+ * Widget tree of BAngrGUI with probed widgets and its compositing layers.
+ */
+struct GuiTree
+{
+	BasicBAngrWidgets<Probe> widgets;
+	std::vector<Layer> layers;
+
+	GuiTree (std::shared_ptr<BAngrResources> sharedResources) :
+		widgets (sharedResources)
+	{
+		// Background first, then its children in pack order. The children
+		// of an FX panel directly follow the panel.
+		layers.reserve (1 + widgets.packOrder().size() + NR_FX * 2 * NR_PARAMS);
+		layers.push_back (Layer {&widgets.mContainer, 0.0, 0.0});
+		for (BWidgets::Widget* w : widgets.packOrder())
+		{
+			const double x = w->getPosition().x;
+			const double y = w->getPosition().y;
+			layers.push_back (Layer {w, x, y, (w == &widgets.cursor)});
+
+			for (Probe<BasicFxPanel<Probe>>& f : widgets.fx)
+			{
+				if (w != &f) continue;
+				for (int j = 0; j < NR_PARAMS; ++j)
+				{
+					f.dials[j].parentX = x;
+					f.dials[j].parentY = y;
+					f.labels[j].parentX = x;
+					f.labels[j].parentY = y;
+					layers.push_back (Layer {&f.dials[j], f.dials[j].getAbsoluteX(), f.dials[j].getAbsoluteY()});
+					layers.push_back (Layer {&f.labels[j], f.labels[j].getAbsoluteX(), f.labels[j].getAbsoluteY()});
+				}
+			}
+		}
+	}
+
+	GuiTree (const GuiTree& that) = delete;
+	GuiTree& operator= (const GuiTree& that) = delete;
+
+	void applyTheme () {widgets.mContainer.setTheme (widgets.resources->getStyles().theme);}
+
+	BAngrDial* getDial (const int controller)
+	{
+		if (controller == DRY_WET) return &widgets.drywetDial;
+		if (controller == SPEED) return &widgets.speedDial;
+		if (controller == SPIN) return &widgets.spinDial;
+		if ((controller >= FX) && (controller < FX + NR_FX * NR_PARAMS)) return &widgets.fx[(controller - FX) / NR_PARAMS].dials[(controller - FX) % NR_PARAMS];
+		return nullptr;
+	}
+};
+
+/*
+ * Offscreen window: Composites the damaged areas of all layers.
+ */
+class Offscreen
+{
+public:
+	Offscreen () : surface_ (nullptr), zoom_ (0.0) {}
+	~Offscreen () {if (surface_) cairo_surface_destroy (surface_);}
+
+	void resize (const double zoom)
+	{
+		if (zoom == zoom_) return;
+		if (surface_) cairo_surface_destroy (surface_);
+		surface_ = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, ceil (GUIBENCH_WIDTH * zoom), ceil (GUIBENCH_HEIGHT * zoom));
+		cairo_surface_set_device_scale (surface_, zoom, zoom);
+		zoom_ = zoom;
+	}
+
+	/*
+	 * Composites the damages and returns the number of repainted device
+	 * pixels.
+	 */
+	double composite (const std::vector<Layer>& layers, const std::vector<Damage>& damages)
+	{
+		double pixels = 0.0;
+		cairo_t* cr = cairo_create (surface_);
+		for (const Damage& d : damages)
+		{
+			const double x0 = std::max (d.x, 0.0);
+			const double y0 = std::max (d.y, 0.0);
+			const double x1 = std::min (d.x + d.width, GUIBENCH_WIDTH);
+			const double y1 = std::min (d.y + d.height, GUIBENCH_HEIGHT);
+			if ((x1 <= x0) || (y1 <= y0)) continue;
+			pixels += (ceil (x1 * zoom_) - floor (x0 * zoom_)) * (ceil (y1 * zoom_) - floor (y0 * zoom_));
+
+			cairo_save (cr);
+			cairo_rectangle (cr, x0, y0, x1 - x0, y1 - y0);
+			cairo_clip (cr);
+			for (const Layer& l : layers)
+			{
+				if ((!l.widget->isVisible()) || (!l.widget->cairoSurface())) continue;
+				const double lx = (l.moving ? l.widget->getPosition().x : l.x);
+				const double ly = (l.moving ? l.widget->getPosition().y : l.y);
+				if ((lx >= x1) || (ly >= y1) || (lx + l.widget->getWidth() <= x0) || (ly + l.widget->getHeight() <= y0)) continue;
+				cairo_set_source_surface (cr, l.widget->cairoSurface(), lx, ly);
+				cairo_paint (cr);
+			}
+			cairo_restore (cr);
+		}
+		cairo_destroy (cr);
+		cairo_surface_flush (surface_);
+		return pixels;
+	}
+
+private:
+	cairo_surface_t* surface_;
+	double zoom_;
+};
+
+struct GuiResult
+{
+	uint64_t frames;
+	double mean;
+	double p50;
+	double p99;
+	double max;
+	double drawShare;
+	double pixelsMean;
+	double pixelsP50;
+	double pixelsP99;
+	double pixelsMax;
+};
+
+static void moveCursor (GuiTree& tree, const double zoom, const double xcursor, const double ycursor)
+{
+	// Moving doesn't redraw the dot, but the window repaints the old and
+	// the new cursor area
+	const Damage from {tree.widgets.cursor.getPosition().x, tree.widgets.cursor.getPosition().y, tree.widgets.cursor.getWidth(), tree.widgets.cursor.getHeight()};
+	if (!tree.widgets.moveCursor (xcursor, ycursor, zoom)) return;
+	damages.push_back (from);
+	damages.push_back (Damage {tree.widgets.cursor.getPosition().x, tree.widgets.cursor.getPosition().y, tree.widgets.cursor.getWidth(), tree.widgets.cursor.getHeight()});
+}
+
+static GuiResult runScenario (const int scenario, const uint64_t frames, const uint64_t seed, const double baseZoom, const std::string& bundle)
+{
+	static const double zooms[] = {1.0, 1.25, 1.5, 2.0, 0.75};
+
+	RTRand rnd;
+	rnd.seed (seed);
+	GuiTree tree (BAngrResources::acquire (bundle + "inc/surface.png"));
+	tree.applyTheme();
+	Offscreen window;
+	double zoom = baseZoom;
+	tree.widgets.mContainer.setZoom (zoom);
+	window.resize (zoom);
+
+	// Initial full frame, not measured
+	damages.clear();
+	tree.widgets.mContainer.update();
+	window.composite (tree.layers, std::vector<Damage> {Damage {0, 0, GUIBENCH_WIDTH, GUIBENCH_HEIGHT}});
+
+	const bool cursor = (scenario == GUI_CURSOR) || (scenario == GUI_MIXED);
+	const bool automation = (scenario == GUI_AUTOMATION) || (scenario == GUI_MIXED);
+	const bool zoomChanges = (scenario == GUI_ZOOM) || (scenario == GUI_MIXED);
+	const bool presets = (scenario == GUI_PRESET) || (scenario == GUI_MIXED);
+	std::vector<double> frameNs;
+	std::vector<double> pixels;
+	frameNs.reserve (frames);
+	pixels.reserve (frames);
+	double total = 0.0;
+	double totalDraw = 0.0;
+	double trailCount = 0.0;
+	GuiResult result {frames, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+	for (uint64_t f = 0; f < frames; ++f)
+	{
+		const double t = f / GUIBENCH_FRAME_RATE;
+		damages.clear();
+		drawNs = 0.0;
+		const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+		// DSP load meter, updated by the host a few times per second
+		if (f % 8 == 0) tree.widgets.loadMeter.setLoad (20.0f + 10.0f * rnd.rand());
+
+		// Cursor on a Lissajous path with trail points at the DSP trail rate
+		if (cursor)
+		{
+			const double x = 0.5 + 0.45 * sin (2.0 * M_PI * 0.31 * t);
+			const double y = 0.5 + 0.45 * sin (2.0 * M_PI * 0.47 * t + 1.0);
+			moveCursor (tree, zoom, x, y);
+			trailCount += BANGR_TRAIL_RATE / GUIBENCH_FRAME_RATE;
+			if (trailCount >= 1.0)
+			{
+				const uint32_t point = packTrailPoint (x, y);
+				tree.widgets.trail.addPoints (&point, 1);
+				tree.widgets.trail.update();
+				trailCount -= 1.0;
+			}
+		}
+
+		// Host automation of a few dials per frame
+		if (automation)
+		{
+			const int count = 1 + int (rnd.rand_range (0.0f, 2.99f));
+			for (int i = 0; i < count; ++i)
+			{
+				BAngrDial* d = tree.getDial (FX + int (rnd.rand_range (0.0f, NR_FX * NR_PARAMS - 0.01f)));
+				if (d) d->setValue (d->getValue() + rnd.rand_range (-0.02f, 0.02f) * (d->getMax() - d->getMin()));
+			}
+		}
+
+		// Preset load: all dials at once, twice per second
+		if (presets && (f % 30 == 15))
+		{
+			for (int c = 0; c < NR_CONTROLLERS; ++c)
+			{
+				BAngrDial* d = tree.getDial (c);
+				if (d) d->setValue (d->getMin() + rnd.rand() * (d->getMax() - d->getMin()));
+			}
+		}
+
+		// Zoom change (window resize by the user) once per second
+		if (zoomChanges && (f % 60 == 59))
+		{
+			zoom = baseZoom * zooms[(f / 60) % (sizeof (zooms) / sizeof (zooms[0]))];
+			tree.widgets.mContainer.setZoom (zoom);
+			window.resize (zoom);
+			damages.push_back (Damage {0, 0, GUIBENCH_WIDTH, GUIBENCH_HEIGHT});
+		}
+
+		const double px = window.composite (tree.layers, damages);
+		const double ns = std::chrono::duration<double, std::nano> (std::chrono::steady_clock::now() - t0).count();
+		frameNs.push_back (ns);
+		pixels.push_back (px);
+		total += ns;
+		totalDraw += drawNs;
+		result.pixelsMean += px;
+		result.max = std::max (result.max, ns);
+		result.pixelsMax = std::max (result.pixelsMax, px);
+	}
+
+	result.mean = (frames ? total / frames : 0.0);
+	result.p50 = percentile (frameNs, 0.5);
+	result.p99 = percentile (frameNs, 0.99);
+	result.drawShare = (total > 0.0 ? 100.0 * totalDraw / total : 0.0);
+	result.pixelsMean = (frames ? result.pixelsMean / frames : 0.0);
+	result.pixelsP50 = percentile (pixels, 0.5);
+	result.pixelsP99 = percentile (pixels, 0.99);
+	return result;
+}
+
+enum StartupPhase
+{
+	STARTUP_RESOURCES,
+	STARTUP_WIDGETS,
+	STARTUP_THEME,
+	STARTUP_FIRST_FRAME,
+	STARTUP_TOTAL,
+	STARTUP_CLOSE,
+	NR_STARTUP_PHASES
+};
+
+const char* startupPhaseNames[NR_STARTUP_PHASES] = {"resources", "widgets", "theme", "first frame", "total", "close"};
+
+/*
+ * Opens and closes the editor widget tree the provided number of times
+ * and measures the phases of each open in ns.
+ */
+static void runStartup (const uint64_t opens, const double zoom, const std::string& bundle, std::array<std::vector<double>, NR_STARTUP_PHASES>& times)
+{
+	for (std::vector<double>& t : times) t.reserve (opens);
+
+	for (uint64_t i = 0; i < opens; ++i)
+	{
+		std::chrono::steady_clock::time_point t[NR_STARTUP_PHASES + 1];
+		t[0] = std::chrono::steady_clock::now();
+
+		std::shared_ptr<BAngrResources> resources = BAngrResources::acquire (bundle + "inc/surface.png");
+		t[1] = std::chrono::steady_clock::now();
+
+		std::unique_ptr<GuiTree> tree (new GuiTree (resources));
+		t[2] = std::chrono::steady_clock::now();
+
+		tree->applyTheme();
+		t[3] = std::chrono::steady_clock::now();
+
+		Offscreen window;
+		damages.clear();
+		tree->widgets.mContainer.setZoom (zoom);
+		window.resize (zoom);
+		for (const Layer& l : tree->layers) l.widget->update();
+		window.composite (tree->layers, std::vector<Damage> {Damage {0, 0, GUIBENCH_WIDTH, GUIBENCH_HEIGHT}});
+		t[4] = std::chrono::steady_clock::now();
+
+		tree.reset();
+		resources.reset();
+		t[5] = std::chrono::steady_clock::now();
+
+		times[STARTUP_RESOURCES].push_back (std::chrono::duration<double, std::nano> (t[1] - t[0]).count());
+		times[STARTUP_WIDGETS].push_back (std::chrono::duration<double, std::nano> (t[2] - t[1]).count());
+		times[STARTUP_THEME].push_back (std::chrono::duration<double, std::nano> (t[3] - t[2]).count());
+		times[STARTUP_FIRST_FRAME].push_back (std::chrono::duration<double, std::nano> (t[4] - t[3]).count());
+		times[STARTUP_TOTAL].push_back (std::chrono::duration<double, std::nano> (t[4] - t[0]).count());
+		times[STARTUP_CLOSE].push_back (std::chrono::duration<double, std::nano> (t[5] - t[4]).count());
+	}
+}
+
+static void printUsage ()
+{
+	fprintf
+	(
+		stderr,
+		"Usage: bangr-guibench [OPTIONS]\n"
+		"  --frames N        Frames per scenario (default 600, 10 s at 60 Hz)\n"
+		"  --seed N          Seed of the scripted activity (default 1)\n"
+		"  --zoom Z          Base zoom factor (default 1)\n"
+		"  --bundle PATH     Path of the plugin bundle with inc/surface.png (default ./)\n"
+		"  --scenario NAME   Only run idle, cursor, automation, zoom, preset or mixed\n"
+		"  --startup N       Measure N editor opens instead of rendering\n"
+		"  --help            Show this help\n"
+	);
+}
+
+int main (int argc, char** argv)
+{
+	uint64_t frames = 600;
+	uint64_t seed = 1;
+	double zoom = 1.0;
+	std::string bundle = "./";
+	int only = -1;
+	uint64_t opens = 0;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if ((strcmp (argv[i], "--frames") == 0) && (i + 1 < argc)) frames = strtoull (argv[++i], nullptr, 10);
+		else if ((strcmp (argv[i], "--seed") == 0) && (i + 1 < argc)) seed = strtoull (argv[++i], nullptr, 10);
+		else if ((strcmp (argv[i], "--zoom") == 0) && (i + 1 < argc)) zoom = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--startup") == 0) && (i + 1 < argc)) opens = strtoull (argv[++i], nullptr, 10);
+		else if ((strcmp (argv[i], "--bundle") == 0) && (i + 1 < argc))
+		{
+			bundle = argv[++i];
+			if ((!bundle.empty()) && (bundle.back() != '/')) bundle += "/";
+		}
+		else if ((strcmp (argv[i], "--scenario") == 0) && (i + 1 < argc))
+		{
+			const char* name = argv[++i];
+			for (int s = 0; s < NR_GUI_SCENARIOS; ++s)
+			{
+				if (strcmp (name, scenarioNames[s]) == 0) only = s;
+			}
+			if (only < 0)
+			{
+				printUsage();
+				return 1;
+			}
+		}
+		else
+		{
+			printUsage();
+			return (strcmp (argv[i], "--help") == 0 ? 0 : 1);
+		}
+	}
+
+	if ((frames == 0) || !(zoom >= 0.25) || !(zoom <= 4.0))
+	{
+		printUsage();
+		return 1;
+	}
+
+	if (opens)
+	{
+		std::array<std::vector<double>, NR_STARTUP_PHASES> times;
+		runStartup (opens, zoom, bundle, times);
+
+		printf ("GUI startup: %lu opens, zoom %.2f\n\n", (unsigned long) opens, zoom);
+		printf ("%-12s %10s %10s %10s %10s %10s\n", "phase", "first", "mean", "p50", "p99", "max");
+		for (int p = 0; p < NR_STARTUP_PHASES; ++p)
+		{
+			// First open loads the shared resources, the others re-open
+			std::vector<double> reopens (times[p].begin() + 1, times[p].end());
+			double mean = 0.0;
+			for (const double t : reopens) mean += t;
+			mean = (reopens.empty() ? 0.0 : mean / reopens.size());
+			printf
+			(
+				"%-12s %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+				startupPhaseNames[p], times[p].front() * 0.001, mean * 0.001, percentile (reopens, 0.5) * 0.001,
+				percentile (reopens, 0.99) * 0.001, (reopens.empty() ? 0.0 : *std::max_element (reopens.begin(), reopens.end())) * 0.001
+			);
+		}
+		printf ("\nTime in us. First: first open in this process, other columns: re-opens after close.\n");
+		return 0;
+	}
+
+	printf ("GUI render: %lu frames per scenario, zoom %.2f, seed %lu\n\n", (unsigned long) frames, zoom, (unsigned long) seed);
+	printf
+	(
+		"%-11s %8s %10s %10s %10s %10s %8s %10s %10s %10s %10s\n",
+		"scenario", "frames", "mean", "p50", "p99", "max", "draw %", "px mean", "px p50", "px p99", "px max"
+	);
+
+	for (int s = 0; s < NR_GUI_SCENARIOS; ++s)
+	{
+		if ((only >= 0) && (s != only)) continue;
+
+		const GuiResult r = runScenario (s, frames, seed, zoom, bundle);
+		printf
+		(
+			"%-11s %8lu %10.1f %10.1f %10.1f %10.1f %8.1f %10.0f %10.0f %10.0f %10.0f\n",
+			scenarioNames[s], (unsigned long) r.frames, r.mean * 0.001, r.p50 * 0.001, r.p99 * 0.001, r.max * 0.001,
+			r.drawShare, r.pixelsMean, r.pixelsP50, r.pixelsP99, r.pixelsMax
+		);
+		fflush (stdout);
+	}
+
+	printf ("\nFrame time in us (activity, widget draws and compositing). Pixels: repainted device pixels per frame.\n");
+	return 0;
+}
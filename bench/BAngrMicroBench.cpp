@@ -0,0 +1,350 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Component micro-benchmarks for the B.Angr DSP kernels. Each kernel is
+ * measured in several repetitions and the fastest repetition is reported
+ * in ns per operation.
+ *
+ * Baseline files contain one "<name> <ns_per_op>" line per kernel. Lines
+ * starting with # are comments. Baselines are machine-specific and thus not
+ * part of the repository.
+ *
+ * Usage: bangr-microbench [--time S] [--save FILE] [--compare FILE [--tolerance PCT]]
+ * Returns 1 if any kernel is slower than the baseline plus tolerance.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+#include <lv2/atom/forge.h>
+#include "Airwindows/XRegion.hpp"
+#include "BAngrEngine.hpp"
+#include "ButterworthLowPassFilter.hpp"
+#include "ButterworthHighPassFilter.hpp"
+#include "ButterworthBandPassFilter.hpp"
+#include "RTRand.hpp"
+#include "Blend.hpp"
+#include "ControllerLimits.hpp"
+#include "CursorMessage.hpp"
+#include "Ports.hpp"
+
+#define BENCH_BLOCK 1024
+#define BENCH_REPETITIONS 5
+
+struct Kernel
+{
+	std::string name;
+	uint32_t opsPerCall;
+	std::function<void ()> call;
+};
+
+struct KernelResult
+{
+	std::string name;
+	double nsPerOp;
+};
+
+static volatile float sink = 0.0f;
+
+static double measure (const Kernel& kernel, const double seconds)
+{
+	// Warm up and calibrate the number of calls per repetition
+	uint64_t calls = 1;
+	while (true)
+	{
+		const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < calls; ++i) kernel.call();
+		const double dt = std::chrono::duration<double> (std::chrono::steady_clock::now() - t0).count();
+		if (dt >= 0.01)
+		{
+			calls = std::max<uint64_t> (1, calls * (seconds / BENCH_REPETITIONS) / dt);
+			break;
+		}
+		calls *= 2;
+	}
+
+	double best = HUGE_VAL;
+	for (int r = 0; r < BENCH_REPETITIONS; ++r)
+	{
+		const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < calls; ++i) kernel.call();
+		const double dt = std::chrono::duration<double, std::nano> (std::chrono::steady_clock::now() - t0).count();
+		best = std::min (best, dt / (double (calls) * kernel.opsPerCall));
+	}
+	return best;
+}
+
+static bool loadBaseline (const char* filename, std::map<std::string, double>& baseline)
+{
+	FILE* file = fopen (filename, "r");
+	if (!file) return false;
+
+	char line[256];
+	while (fgets (line, sizeof (line), file))
+	{
+		if ((line[0] == '#') || (line[0] == '\n')) continue;
+		char name[128];
+		double ns;
+		if (sscanf (line, "%127s %lf", name, &ns) == 2) baseline[name] = ns;
+	}
+	fclose (file);
+	return true;
+}
+
+static bool saveBaseline (const char* filename, const std::vector<KernelResult>& results)
+{
+	FILE* file = fopen (filename, "w");
+	if (!file) return false;
+
+	fprintf (file, "# B.Angr micro-benchmark baseline (ns per op)\n");
+	for (const KernelResult& r : results) fprintf (file, "%s %.4f\n", r.name.c_str(), r.nsPerOp);
+	fclose (file);
+	return true;
+}
+
+static void printUsage ()
+{
+	fprintf
+	(
+		stderr,
+		"Usage: bangr-microbench [OPTIONS]\n"
+		"  --time S          Measurement time per kernel (default 0.5)\n"
+		"  --save FILE       Store results as baseline\n"
+		"  --compare FILE    Compare results against baseline\n"
+		"  --tolerance PCT   Allowed slowdown in percent (default 10)\n"
+		"  --help            Show this help\n"
+	);
+}
+
+int main (int argc, char** argv)
+{
+	double seconds = 0.5;
+	double tolerance = 10.0;
+	const char* saveFile = nullptr;
+	const char* compareFile = nullptr;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if ((strcmp (argv[i], "--time") == 0) && (i + 1 < argc)) seconds = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--save") == 0) && (i + 1 < argc)) saveFile = argv[++i];
+		else if ((strcmp (argv[i], "--compare") == 0) && (i + 1 < argc)) compareFile = argv[++i];
+		else if ((strcmp (argv[i], "--tolerance") == 0) && (i + 1 < argc)) tolerance = atof (argv[++i]);
+		else
+		{
+			printUsage();
+			return (strcmp (argv[i], "--help") == 0 ? 0 : 1);
+		}
+	}
+
+	if (!(seconds > 0.0) || !(tolerance >= 0.0))
+	{
+		printUsage();
+		return 1;
+	}
+
+	std::map<std::string, double> baseline;
+	if (compareFile && !loadBaseline (compareFile, baseline))
+	{
+		fprintf (stderr, "Can't read baseline file %s.\n", compareFile);
+		return 1;
+	}
+
+	// Test data
+	const double rate = 48000.0;
+	RTRand rnd;
+	std::vector<float> in1 (BENCH_BLOCK);
+	std::vector<float> in2 (BENCH_BLOCK);
+	std::vector<float> out1 (BENCH_BLOCK);
+	std::vector<float> out2 (BENCH_BLOCK);
+	for (int i = 0; i < BENCH_BLOCK; ++i)
+	{
+		in1[i] = rnd.rand_range (-1.0f, 1.0f);
+		in2[i] = rnd.rand_range (-1.0f, 1.0f);
+	}
+
+	float fx[NR_FX * NR_PARAMS];
+	for (int i = 0; i < NR_FX * NR_PARAMS; ++i) fx[i] = controllerDefaults[FX + i];
+	float params[NR_PARAMS];
+	float params2[NR_PARAMS];
+	blendParams (0.25f, 0.75f, fx, params);
+	blendParams (0.75f, 0.25f, fx, params2);
+
+	XRegion xregion (rate);
+	xregion.setParameters (params);
+	BAngrEngine engine (rate, BENCH_BLOCK);
+	for (int i = 0; i < NR_CONTROLLERS; ++i) engine.setController (i, controllerDefaults[i]);
+	XRegion xregionParam (rate);
+	ButterworthLowPassFilter lowpass (rate, 200.0, 8);
+	ButterworthHighPassFilter highpass (rate, 4000.0, 8);
+	ButterworthBandPassFilter bandpass (rate, 200.0, 4000.0, 8);
+
+	LV2_URID_Map map {nullptr, [] (LV2_URID_Map_Handle, const char* uri) -> LV2_URID {return std::hash<std::string>{} (uri) & 0x7fffffff;}};
+	BAngrURIs urids;
+	getURIs (&map, &urids);
+	LV2_Atom_Forge forge;
+	lv2_atom_forge_init (&forge, &map);
+	std::vector<uint64_t> forgeBuffer (4096);
+	LV2_Atom_Forge_Frame sequenceFrame;
+
+	const std::vector<Kernel> kernels =
+	{
+		{
+			"xregion_process", BENCH_BLOCK, [&] ()
+			{
+				xregion.process (in1.data(), in2.data(), out1.data(), out2.data(), BENCH_BLOCK);
+				sink = out1[BENCH_BLOCK - 1];
+			}
+		},
+
+		// Complete engine without LV2 dispatch
+		{
+			"engine_process", BENCH_BLOCK, [&] ()
+			{
+				engine.process (in1.data(), in2.data(), out1.data(), out2.data(), BENCH_BLOCK);
+				sink = out1[BENCH_BLOCK - 1];
+			}
+		},
+
+		// Includes the coefficient update which is lazily done in the next process() call
+		{
+			"xregion_setParameters", 2, [&] ()
+			{
+				xregionParam.setParameters (params);
+				xregionParam.process (&in1[0], &in2[0], &out1[0], &out2[0], 1);
+				xregionParam.setParameters (params2);
+				xregionParam.process (&in1[1], &in2[1], &out1[1], &out2[1], 1);
+				sink = out1[1];
+			}
+		},
+
+		{
+			"butterworth_lowpass", BENCH_BLOCK, [&] ()
+			{
+				float s = 0.0f;
+				for (int i = 0; i < BENCH_BLOCK; ++i) s += lowpass.process (in1[i]);
+				sink = s;
+			}
+		},
+
+		{
+			"butterworth_highpass", BENCH_BLOCK, [&] ()
+			{
+				float s = 0.0f;
+				for (int i = 0; i < BENCH_BLOCK; ++i) s += highpass.process (in1[i]);
+				sink = s;
+			}
+		},
+
+		{
+			"butterworth_bandpass", BENCH_BLOCK, [&] ()
+			{
+				float s = 0.0f;
+				for (int i = 0; i < BENCH_BLOCK; ++i) s += bandpass.process (in1[i]);
+				sink = s;
+			}
+		},
+
+		{
+			"rtrand_rand_range", BENCH_BLOCK, [&] ()
+			{
+				float s = 0.0f;
+				for (int i = 0; i < BENCH_BLOCK; ++i) s += rnd.rand_range (-1.0f, 1.0f);
+				sink = s;
+			}
+		},
+
+		{
+			"blend_params", BENCH_BLOCK, [&] ()
+			{
+				float s = 0.0f;
+				for (int i = 0; i < BENCH_BLOCK; ++i)
+				{
+					blendParams (in1[i] * 0.5f + 0.5f, in2[i] * 0.5f + 0.5f, fx, params2);
+					s += params2[PARAM_NUKE];
+				}
+				sink = s;
+			}
+		},
+
+		{
+			"forge_cursor", 64, [&] ()
+			{
+				lv2_atom_forge_set_buffer (&forge, reinterpret_cast<uint8_t*> (forgeBuffer.data()), forgeBuffer.size() * sizeof (uint64_t));
+				lv2_atom_forge_sequence_head (&forge, &sequenceFrame, 0);
+				for (int i = 0; i < 64; ++i) forgeCursor (&forge, urids, 0, true, in1[i], (i & 1), in2[i]);
+				lv2_atom_forge_pop (&forge, &sequenceFrame);
+				sink = forgeBuffer[1];
+			}
+		}
+	};
+
+	std::vector<KernelResult> results;
+	bool regression = false;
+
+	printf ("%-24s %12s", "kernel", "ns/op");
+	if (compareFile) printf (" %12s %9s", "baseline", "change");
+	printf ("\n");
+
+	for (const Kernel& k : kernels)
+	{
+		const double ns = measure (k, seconds);
+		results.push_back (KernelResult {k.name, ns});
+		printf ("%-24s %12.4f", k.name.c_str(), ns);
+
+		if (compareFile)
+		{
+			std::map<std::string, double>::const_iterator it = baseline.find (k.name);
+			if ((it != baseline.end()) && (it->second > 0.0))
+			{
+				const double change = 100.0 * (ns - it->second) / it->second;
+				const bool failed = (change > tolerance);
+				printf (" %12.4f %+8.1f%%%s", it->second, change, (failed ? "  REGRESSION" : ""));
+				regression = regression || failed;
+			}
+			else printf (" %12s %9s", "-", "new");
+		}
+
+		printf ("\n");
+		fflush (stdout);
+	}
+
+	if (saveFile && !saveBaseline (saveFile, results))
+	{
+		fprintf (stderr, "Can't write baseline file %s.\n", saveFile);
+		return 1;
+	}
+
+	if (regression)
+	{
+		fprintf (stderr, "Regression beyond %.1f%% tolerance.\n", tolerance);
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,514 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Real-time safety verifier for BAngr::run(). Interposes the memory
+ * allocation functions, operator new / delete, the mutex and condition
+ * primitives and common blocking syscalls. Any call of them while run() is
+ * executed is counted as violation. Runs a long randomized session (random
+ * block sizes, controller changes, GUI messages, silence, denormals and
+ * clipping input) and reports the worst-case run() execution times per
+ * session quarter and per input type to reveal slowly growing costs and
+ * denormal storms. The DSP engine enables flush-to-zero and
+ * denormals-are-zero itself while processing. Outside (input generation,
+ * plugin adapter) they are disabled by default (as in hosts which don't set
+ * them) unless --ftz is provided. The second half of the session runs with
+ * an attached telemetry GUI (see Telemetry.hpp) and the telemetry ring is
+ * drained after each block.
+ *
+ * Usage: bangr-rtcheck [--seconds S] [--rate R] [--seed N] [--ftz]
+ * Returns 1 on any violation.
+ */
+
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+#include <dlfcn.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+#include "OfflineHost.hpp"
+#include "ControllerLimits.hpp"
+#include "Ports.hpp"
+#include "RTRand.hpp"
+#include "Telemetry.hpp"
+
+enum RTViolation
+{
+	RT_MALLOC,
+	RT_FREE,
+	RT_NEW,
+	RT_DELETE,
+	RT_MUTEX,
+	RT_COND,
+	RT_IO,
+	RT_SLEEP,
+	RT_MMAP,
+	NR_RT_VIOLATIONS
+};
+
+const char* violationNames[NR_RT_VIOLATIONS] =
+{
+	"malloc/calloc/realloc", "free", "operator new", "operator delete",
+	"mutex", "condition variable", "file / stream I/O", "sleep / yield / poll", "mmap / munmap"
+};
+
+static thread_local bool inRun = false;
+static std::atomic<uint64_t> violations[NR_RT_VIOLATIONS];
+
+static inline void violation (const RTViolation v)
+{
+	if (inRun) violations[v].fetch_add (1, std::memory_order_relaxed);
+}
+
+/*
+ * Interposed functions. Memory allocation uses glibc's internal entry
+ * points as dlsym itself may allocate. All other functions are resolved
+ * lazily via dlsym (RTLD_NEXT).
+ */
+
+extern "C"
+{
+void* __libc_malloc (size_t size);
+void* __libc_calloc (size_t n, size_t size);
+void* __libc_realloc (void* ptr, size_t size);
+void __libc_free (void* ptr);
+void* __libc_memalign (size_t alignment, size_t size);
+}
+
+template <class F>
+static inline F realFunction (F& fn, const char* name)
+{
+	if (!fn) fn = reinterpret_cast<F> (dlsym (RTLD_NEXT, name));
+	return fn;
+}
+
+#define RT_REAL(fn) realFunction (real_##fn, #fn)
+
+extern "C"
+{
+
+void* malloc (size_t size) {violation (RT_MALLOC); return __libc_malloc (size);}
+void* calloc (size_t n, size_t size) {violation (RT_MALLOC); return __libc_calloc (n, size);}
+void* realloc (void* ptr, size_t size) {violation (RT_MALLOC); return __libc_realloc (ptr, size);}
+void free (void* ptr) {violation (RT_FREE); __libc_free (ptr);}
+void* memalign (size_t alignment, size_t size) {violation (RT_MALLOC); return __libc_memalign (alignment, size);}
+void* aligned_alloc (size_t alignment, size_t size) {violation (RT_MALLOC); return __libc_memalign (alignment, size);}
+
+int posix_memalign (void** ptr, size_t alignment, size_t size)
+{
+	violation (RT_MALLOC);
+	void* p = __libc_memalign (alignment, size);
+	if (!p) return ENOMEM;
+	*ptr = p;
+	return 0;
+}
+
+static int (*real_pthread_mutex_lock) (pthread_mutex_t*) = nullptr;
+static int (*real_pthread_mutex_trylock) (pthread_mutex_t*) = nullptr;
+static int (*real_pthread_mutex_unlock) (pthread_mutex_t*) = nullptr;
+static int (*real_pthread_cond_wait) (pthread_cond_t*, pthread_mutex_t*) = nullptr;
+static int (*real_pthread_cond_timedwait) (pthread_cond_t*, pthread_mutex_t*, const struct timespec*) = nullptr;
+static int (*real_pthread_cond_signal) (pthread_cond_t*) = nullptr;
+static int (*real_pthread_cond_broadcast) (pthread_cond_t*) = nullptr;
+static int (*real_open) (const char*, int, ...) = nullptr;
+static int (*real_openat) (int, const char*, int, ...) = nullptr;
+static int (*real_close) (int) = nullptr;
+static ssize_t (*real_read) (int, void*, size_t) = nullptr;
+static ssize_t (*real_write) (int, const void*, size_t) = nullptr;
+static FILE* (*real_fopen) (const char*, const char*) = nullptr;
+static size_t (*real_fwrite) (const void*, size_t, size_t, FILE*) = nullptr;
+static int (*real_vfprintf) (FILE*, const char*, va_list) = nullptr;
+static int (*real_puts) (const char*) = nullptr;
+static int (*real_usleep) (useconds_t) = nullptr;
+static int (*real_nanosleep) (const struct timespec*, struct timespec*) = nullptr;
+static int (*real_clock_nanosleep) (clockid_t, int, const struct timespec*, struct timespec*) = nullptr;
+static int (*real_sched_yield) () = nullptr;
+static int (*real_poll) (struct pollfd*, nfds_t, int) = nullptr;
+static void* (*real_mmap) (void*, size_t, int, int, int, off_t) = nullptr;
+static int (*real_munmap) (void*, size_t) = nullptr;
+
+int pthread_mutex_lock (pthread_mutex_t* m) {violation (RT_MUTEX); return RT_REAL (pthread_mutex_lock) (m);}
+int pthread_mutex_trylock (pthread_mutex_t* m) {violation (RT_MUTEX); return RT_REAL (pthread_mutex_trylock) (m);}
+int pthread_mutex_unlock (pthread_mutex_t* m) {violation (RT_MUTEX); return RT_REAL (pthread_mutex_unlock) (m);}
+int pthread_cond_wait (pthread_cond_t* c, pthread_mutex_t* m) {violation (RT_COND); return RT_REAL (pthread_cond_wait) (c, m);}
+int pthread_cond_timedwait (pthread_cond_t* c, pthread_mutex_t* m, const struct timespec* t) {violation (RT_COND); return RT_REAL (pthread_cond_timedwait) (c, m, t);}
+int pthread_cond_signal (pthread_cond_t* c) {violation (RT_COND); return RT_REAL (pthread_cond_signal) (c);}
+int pthread_cond_broadcast (pthread_cond_t* c) {violation (RT_COND); return RT_REAL (pthread_cond_broadcast) (c);}
+
+int open (const char* path, int flags, ...)
+{
+	violation (RT_IO);
+	va_list args;
+	va_start (args, flags);
+	const mode_t mode = ((flags & O_CREAT) ? va_arg (args, int) : 0);
+	va_end (args);
+	return RT_REAL (open) (path, flags, mode);
+}
+
+int openat (int dirfd, const char* path, int flags, ...)
+{
+	violation (RT_IO);
+	va_list args;
+	va_start (args, flags);
+	const mode_t mode = ((flags & O_CREAT) ? va_arg (args, int) : 0);
+	va_end (args);
+	return RT_REAL (openat) (dirfd, path, flags, mode);
+}
+
+int close (int fd) {violation (RT_IO); return RT_REAL (close) (fd);}
+ssize_t read (int fd, void* buf, size_t n) {violation (RT_IO); return RT_REAL (read) (fd, buf, n);}
+ssize_t write (int fd, const void* buf, size_t n) {violation (RT_IO); return RT_REAL (write) (fd, buf, n);}
+FILE* fopen (const char* path, const char* mode) {violation (RT_IO); return RT_REAL (fopen) (path, mode);}
+size_t fwrite (const void* ptr, size_t size, size_t n, FILE* stream) {violation (RT_IO); return RT_REAL (fwrite) (ptr, size, n, stream);}
+int vfprintf (FILE* stream, const char* format, va_list args) {violation (RT_IO); return RT_REAL (vfprintf) (stream, format, args);}
+int puts (const char* s) {violation (RT_IO); return RT_REAL (puts) (s);}
+
+int fprintf (FILE* stream, const char* format, ...)
+{
+	va_list args;
+	va_start (args, format);
+	const int r = vfprintf (stream, format, args);
+	va_end (args);
+	return r;
+}
+
+int printf (const char* format, ...)
+{
+	va_list args;
+	va_start (args, format);
+	const int r = vfprintf (stdout, format, args);
+	va_end (args);
+	return r;
+}
+
+int usleep (useconds_t us) {violation (RT_SLEEP); return RT_REAL (usleep) (us);}
+int nanosleep (const struct timespec* t, struct timespec* rem) {violation (RT_SLEEP); return RT_REAL (nanosleep) (t, rem);}
+int clock_nanosleep (clockid_t c, int flags, const struct timespec* t, struct timespec* rem) {violation (RT_SLEEP); return RT_REAL (clock_nanosleep) (c, flags, t, rem);}
+int sched_yield () {violation (RT_SLEEP); return RT_REAL (sched_yield) ();}
+int poll (struct pollfd* fds, nfds_t n, int timeout) {violation (RT_SLEEP); return RT_REAL (poll) (fds, n, timeout);}
+void* mmap (void* addr, size_t length, int prot, int flags, int fd, off_t offset) {violation (RT_MMAP); return RT_REAL (mmap) (addr, length, prot, flags, fd, offset);}
+int munmap (void* addr, size_t length) {violation (RT_MMAP); return RT_REAL (munmap) (addr, length);}
+
+}
+
+void* operator new (size_t size)
+{
+	violation (RT_NEW);
+	void* p = __libc_malloc (size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[] (size_t size) {return operator new (size);}
+void* operator new (size_t size, const std::nothrow_t&) noexcept {violation (RT_NEW); return __libc_malloc (size ? size : 1);}
+void* operator new[] (size_t size, const std::nothrow_t&) noexcept {violation (RT_NEW); return __libc_malloc (size ? size : 1);}
+
+void* operator new (size_t size, std::align_val_t alignment)
+{
+	violation (RT_NEW);
+	void* p = __libc_memalign (static_cast<size_t> (alignment), size ? size : 1);
+	if (!p) throw std::bad_alloc();
+	return p;
+}
+
+void* operator new[] (size_t size, std::align_val_t alignment) {return operator new (size, alignment);}
+void operator delete (void* ptr) noexcept {violation (RT_DELETE); __libc_free (ptr);}
+void operator delete[] (void* ptr) noexcept {violation (RT_DELETE); __libc_free (ptr);}
+void operator delete (void* ptr, size_t) noexcept {violation (RT_DELETE); __libc_free (ptr);}
+void operator delete[] (void* ptr, size_t) noexcept {violation (RT_DELETE); __libc_free (ptr);}
+void operator delete (void* ptr, std::align_val_t) noexcept {violation (RT_DELETE); __libc_free (ptr);}
+void operator delete[] (void* ptr, std::align_val_t) noexcept {violation (RT_DELETE); __libc_free (ptr);}
+void operator delete (void* ptr, size_t, std::align_val_t) noexcept {violation (RT_DELETE); __libc_free (ptr);}
+void operator delete[] (void* ptr, size_t, std::align_val_t) noexcept {violation (RT_DELETE); __libc_free (ptr);}
+
+/*
+ * Randomized session
+ */
+
+#define RT_QUARTERS 4
+#define RT_WORST 5
+
+enum InputType
+{
+	INPUT_NOISE,
+	INPUT_SINE,
+	INPUT_SILENCE,
+	INPUT_DENORMAL,
+	INPUT_CLIP,
+	NR_INPUTS
+};
+
+const char* inputNames[NR_INPUTS] = {"noise", "sine", "silence", "denormal", "clip"};
+
+struct BlockTime
+{
+	double ns;
+	double nsPerSample;
+	double time;
+	uint32_t frames;
+	int input;
+};
+
+static void printUsage ()
+{
+	fprintf
+	(
+		stderr,
+		"Usage: bangr-rtcheck [OPTIONS]\n"
+		"  --seconds S   Session length in seconds of audio (default 600)\n"
+		"  --rate R      Sample rate (default 48000)\n"
+		"  --seed N      Seed of the randomized session (default 1)\n"
+		"  --ftz         Enable flush-to-zero and denormals-are-zero\n"
+		"  --help        Show this help\n"
+	);
+}
+
+int main (int argc, char** argv)
+{
+	double seconds = 600.0;
+	double rate = 48000.0;
+	uint64_t seed = 1;
+	bool ftz = false;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if ((strcmp (argv[i], "--seconds") == 0) && (i + 1 < argc)) seconds = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--rate") == 0) && (i + 1 < argc)) rate = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--seed") == 0) && (i + 1 < argc)) seed = strtoull (argv[++i], nullptr, 10);
+		else if (strcmp (argv[i], "--ftz") == 0) ftz = true;
+		else
+		{
+			printUsage();
+			return (strcmp (argv[i], "--help") == 0 ? 0 : 1);
+		}
+	}
+
+	if (!(seconds > 0.0) || !(rate >= 8000.0))
+	{
+		printUsage();
+		return 1;
+	}
+
+#if defined(__SSE__)
+	// FTZ (bit 15) and DAZ (bit 6)
+	if (ftz) _mm_setcsr (_mm_getcsr() | 0x8040);
+	else _mm_setcsr (_mm_getcsr() & ~0x8040);
+#endif
+
+	const uint32_t maxBlock = 4096;
+	const uint64_t nframes = seconds * rate;
+	RTRand rnd;
+	rnd.seed (seed);
+
+	OfflineHost host (rate);
+	host.getPlugin().seed (seed);
+	const BAngrURIs& urids = host.getURIs();
+	std::vector<float> in1 (maxBlock);
+	std::vector<float> in2 (maxBlock);
+	std::vector<float> out1 (maxBlock);
+	std::vector<float> out2 (maxBlock);
+	std::vector<BlockTime> worst (RT_WORST, BlockTime {0.0, 0.0, 0.0, 0, 0});
+	double quarterMax[RT_QUARTERS] = {0.0};
+	double quarterSum[RT_QUARTERS] = {0.0};
+	uint64_t quarterFrames[RT_QUARTERS] = {0};
+	double inputMax[NR_INPUTS] = {0.0};
+	double inputSum[NR_INPUTS] = {0.0};
+	uint64_t inputFrames[NR_INPUTS] = {0};
+
+	bool uiOn = false;
+	int input = INPUT_NOISE;
+	uint64_t inputEnd = 0;
+	double phase = 0.0;
+	uint64_t blocks = 0;
+	BAngrTelemetry& telemetry = host.getPlugin().telemetry;
+	uint64_t telemetryBlocks = 0;
+	uint64_t telemetrySamples = 0;
+
+	for (uint64_t pos = 0; pos < nframes; )
+	{
+		// Block size: mostly powers of two, sometimes arbitrary
+		uint32_t n = (rnd.rand() < 0.7f ? (16u << int (rnd.rand_range (0.0f, 6.99f))) : 1 + uint32_t (rnd.rand_range (0.0f, maxBlock - 1.0f)));
+		n = std::min<uint64_t> (n, nframes - pos);
+
+		// Input segments
+		if (pos >= inputEnd)
+		{
+			input = int (rnd.rand_range (0.0f, NR_INPUTS - 0.01f));
+			inputEnd = pos + uint64_t (rnd.rand_range (0.1f, 4.0f) * rate);
+		}
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			switch (input)
+			{
+				case INPUT_NOISE:	in1[i] = rnd.rand_range (-0.5f, 0.5f);
+							in2[i] = rnd.rand_range (-0.5f, 0.5f);
+							break;
+
+				case INPUT_SINE:	phase += 2.0 * M_PI * 220.0 / rate;
+							if (phase > 2.0 * M_PI) phase -= 2.0 * M_PI;
+							in1[i] = 0.5f * sin (phase);
+							in2[i] = 0.5f * cos (phase);
+							break;
+
+				case INPUT_SILENCE:	in1[i] = 0.0f;
+							in2[i] = 0.0f;
+							break;
+
+				case INPUT_DENORMAL:	in1[i] = rnd.rand_range (-1e-39f, 1e-39f);
+							in2[i] = rnd.rand_range (-1e-39f, 1e-39f);
+							break;
+
+				default:		in1[i] = (i & 1 ? 4.0f : -4.0f);
+							in2[i] = (i & 2 ? 4.0f : -4.0f);
+			}
+		}
+
+		// Attach the telemetry GUI for the second half. It also sends uiOn,
+		// further uiOn / uiOff toggles are from other GUIs.
+		if ((pos >= nframes / 2) && (!telemetry.attached.load (std::memory_order_relaxed)))
+		{
+			telemetry.attached.store (true, std::memory_order_release);
+			host.sendMessage (0, urids.bangr_uiOn);
+		}
+
+		// Events and controller changes
+		if (rnd.rand() < 0.05f)
+		{
+			const int c = int (rnd.rand_range (0.0f, NR_CONTROLLERS - 0.01f));
+			host.controllers[c] = controllerLimits[c].validate (rnd.rand_range (controllerLimits[c].min, controllerLimits[c].max));
+		}
+		if (rnd.rand() < 0.02f)
+		{
+			uiOn = !uiOn;
+			host.sendMessage (0, (uiOn ? urids.bangr_uiOn : urids.bangr_uiOff));
+		}
+		if (rnd.rand() < 0.01f) host.sendPatchSet (0, urids.bangr_notifyRate, rnd.rand_range (0.0f, 200.0f));
+		if (rnd.rand() < 0.2f)
+		{
+			const int64_t frame = rnd.rand_range (0.0f, n - 1.0f);
+			host.sendCursor (frame, rnd.rand_range (-0.1f, 1.1f), rnd.rand_range (-0.1f, 1.1f), rnd.rand() < 0.8f);
+		}
+
+		inRun = true;
+		const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		host.run (in1.data(), in2.data(), out1.data(), out2.data(), n);
+		const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+		inRun = false;
+
+		if (telemetry.attached.load (std::memory_order_relaxed))
+		{
+			TelemetrySample sample;
+			while (telemetry.ring.pop (sample)) ++telemetrySamples;
+			++telemetryBlocks;
+		}
+
+		const double ns = std::chrono::duration<double, std::nano> (t1 - t0).count();
+		const BlockTime bt {ns, ns / n, pos / rate, n, input};
+		const int q = std::min<int> (RT_QUARTERS - 1, pos * RT_QUARTERS / nframes);
+		quarterMax[q] = std::max (quarterMax[q], bt.nsPerSample);
+		quarterSum[q] += ns;
+		quarterFrames[q] += n;
+		inputMax[input] = std::max (inputMax[input], bt.nsPerSample);
+		inputSum[input] += ns;
+		inputFrames[input] += n;
+		if (bt.ns > worst.back().ns)
+		{
+			worst.back() = bt;
+			std::sort (worst.begin(), worst.end(), [] (const BlockTime& a, const BlockTime& b) {return a.ns > b.ns;});
+		}
+
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			if (!std::isfinite (out1[i]) || !std::isfinite (out2[i]))
+			{
+				fprintf (stderr, "Non-finite output at %.3f s.\n", (pos + i) / rate);
+				return 1;
+			}
+		}
+
+		pos += n;
+		++blocks;
+	}
+
+	printf
+	(
+		"Session: %.0f s at %.0f Hz, %lu blocks, seed %lu, FTZ/DAZ %s\n\n",
+		seconds, rate, (unsigned long) blocks, (unsigned long) seed, (ftz ? "on" : "off")
+	);
+
+	printf ("%-8s %14s %14s\n", "quarter", "mean ns/smp", "max ns/smp");
+	for (int q = 0; q < RT_QUARTERS; ++q)
+	{
+		printf ("%-8d %14.3f %14.3f\n", q + 1, (quarterFrames[q] ? quarterSum[q] / quarterFrames[q] : 0.0), quarterMax[q]);
+	}
+
+	printf ("\n%-8s %14s %14s\n", "input", "mean ns/smp", "max ns/smp");
+	for (int i = 0; i < NR_INPUTS; ++i)
+	{
+		printf ("%-8s %14.3f %14.3f\n", inputNames[i], (inputFrames[i] ? inputSum[i] / inputFrames[i] : 0.0), inputMax[i]);
+	}
+
+	printf ("\n%-10s %8s %12s %12s %-9s\n", "time [s]", "frames", "run() [us]", "ns/sample", "input");
+	for (const BlockTime& bt : worst)
+	{
+		if (bt.frames) printf ("%-10.3f %8u %12.3f %12.3f %-9s\n", bt.time, bt.frames, bt.ns * 0.001, bt.nsPerSample, inputNames[bt.input]);
+	}
+
+	bool failed = false;
+	printf ("\nTelemetry: %lu samples drained in %lu blocks\n", (unsigned long) telemetrySamples, (unsigned long) telemetryBlocks);
+	if (telemetrySamples != telemetryBlocks)
+	{
+		printf ("VIOLATION: Telemetry samples lost\n");
+		failed = true;
+	}
+	printf ("\n");
+	for (int v = 0; v < NR_RT_VIOLATIONS; ++v)
+	{
+		const uint64_t count = violations[v].load();
+		if (count)
+		{
+			printf ("VIOLATION: %s called %lu times in run()\n", violationNames[v], (unsigned long) count);
+			failed = true;
+		}
+	}
+	printf ("%s\n", (failed ? "Real-time safety check FAILED." : "Real-time safety check passed."));
+
+	return (failed ? 1 : 0);
+}
@@ -0,0 +1,288 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Stress benchmark for BAngr::run() under host conditions which aren't
+ * covered by averages over large blocks: odd and tiny block sizes, dense
+ * cursor events (patch:Set and combined cursor messages), cursorOn /
+ * cursorOff toggles and controller changes in each block. Each scenario is
+ * run for the provided time of audio and reports the distribution of the
+ * run() time per sample (mean, percentiles and worst case) together with the
+ * worst block.
+ *
+ * Usage: bangr-stress [--seconds S] [--rate R] [--seed N] [--density D] [--scenario NAME]
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+#include "OfflineHost.hpp"
+#include "Percentile.hpp"
+#include "ControllerLimits.hpp"
+#include "Ports.hpp"
+#include "RTRand.hpp"
+
+#define STRESS_MAX_BLOCK 1024
+#define STRESS_CONTROL_SIZE (1 << 20)
+
+enum StressScenario
+{
+	STRESS_STEADY,
+	STRESS_TINY,
+	STRESS_EVENTS,
+	STRESS_AUTOMATION,
+	STRESS_MIXED,
+	NR_STRESS_SCENARIOS
+};
+
+const char* scenarioNames[NR_STRESS_SCENARIOS] = {"steady", "tiny", "events", "automation", "mixed"};
+
+struct StressResult
+{
+	uint64_t blocks;
+	uint64_t events;
+	double mean;
+	double p50;
+	double p99;
+	double p999;
+	double max;
+	double worstNs;
+	uint32_t worstFrames;
+	uint32_t worstEvents;
+};
+
+static uint32_t blockSize (const int scenario, RTRand& rnd)
+{
+	static const uint32_t oddSizes[] = {1, 2, 3, 5, 7, 13, 17, 31};
+
+	switch (scenario)
+	{
+		case STRESS_STEADY:	return STRESS_MAX_BLOCK;
+		case STRESS_TINY:	return (rnd.rand() < 0.5f ? oddSizes[int (rnd.rand_range (0.0f, 7.99f))] : 1 + uint32_t (rnd.rand_range (0.0f, 31.99f)));
+		case STRESS_MIXED:	if (rnd.rand() < 0.5f) return 1 + uint32_t (rnd.rand_range (0.0f, 31.99f));
+					/* fall through */
+		default:		return 16 + uint32_t (rnd.rand_range (0.0f, STRESS_MAX_BLOCK - 16.01f));
+	}
+}
+
+/*
+ * Sends on average density messages per frame, sorted by their frame
+ * positions: patch:Set x and y cursor (50%), combined cursor messages (30%)
+ * and cursorOn / cursorOff toggles (20%).
+ */
+static uint32_t sendEvents (OfflineHost& host, const BAngrURIs& urids, RTRand& rnd, const uint32_t n, const float density, bool& listen)
+{
+	const uint32_t count = density * n * rnd.rand_range (0.0f, 2.0f) + 0.5f;
+	uint32_t sent = 0;
+	int64_t frame = 0;
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		// Increasing frame positions, also several events per frame
+		frame = std::min<int64_t> (n - 1, frame + int64_t (rnd.rand_range (0.0f, 2.0f * (n - frame) / (count - i))));
+		const float type = rnd.rand();
+		bool ok;
+
+		if (type < 0.5f)
+		{
+			ok = host.sendPatchSet (frame, urids.bangr_xcursor, rnd.rand_range (0.0f, 1.0f)) &&
+			     host.sendPatchSet (frame, urids.bangr_ycursor, rnd.rand_range (0.0f, 1.0f));
+		}
+		else if (type < 0.8f) ok = host.sendCursor (frame, rnd.rand_range (0.0f, 1.0f), rnd.rand_range (0.0f, 1.0f), listen);
+		else
+		{
+			listen = !listen;
+			ok = host.sendMessage (frame, (listen ? urids.bangr_cursorOn : urids.bangr_cursorOff));
+		}
+
+		if (!ok) break;
+		++sent;
+	}
+
+	return sent;
+}
+
+static void changeControllers (OfflineHost& host, RTRand& rnd, const int count)
+{
+	for (int i = 0; i < count; ++i)
+	{
+		const int c = int (rnd.rand_range (0.0f, NR_CONTROLLERS - 0.01f));
+		if (c == BYPASS) continue;
+		const Limit& l = controllerLimits[c];
+		host.controllers[c] = l.validate (host.controllers[c] + rnd.rand_range (-0.05f, 0.05f) * (l.max - l.min));
+	}
+}
+
+static StressResult runScenario (const int scenario, const double rate, const double seconds, const uint64_t seed, const float density)
+{
+	const uint64_t nframes = seconds * rate;
+	RTRand rnd;
+	rnd.seed (seed);
+
+	OfflineHost host (rate, STRESS_CONTROL_SIZE);
+	host.getPlugin().seed (seed);
+	const BAngrURIs& urids = host.getURIs();
+	std::vector<float> in1 (STRESS_MAX_BLOCK);
+	std::vector<float> in2 (STRESS_MAX_BLOCK);
+	std::vector<float> out1 (STRESS_MAX_BLOCK);
+	std::vector<float> out2 (STRESS_MAX_BLOCK);
+	std::vector<double> nsPerSample;
+	nsPerSample.reserve (nframes / 16 + 1);
+
+	StressResult result {0, 0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0, 0};
+	double total = 0.0;
+	bool listen = false;
+	const bool events = (scenario == STRESS_EVENTS) || (scenario == STRESS_MIXED) || (scenario == STRESS_TINY);
+	const bool automation = (scenario == STRESS_AUTOMATION) || (scenario == STRESS_MIXED);
+
+	// GUI open: cursor notifications are forged in each run()
+	host.sendMessage (0, urids.bangr_uiOn);
+
+	for (uint64_t pos = 0; pos < nframes; )
+	{
+		const uint32_t n = std::min<uint64_t> (blockSize (scenario, rnd), nframes - pos);
+		for (uint32_t i = 0; i < n; ++i)
+		{
+			in1[i] = rnd.rand_range (-0.5f, 0.5f);
+			in2[i] = rnd.rand_range (-0.5f, 0.5f);
+		}
+
+		const uint32_t nEvents = (events ? sendEvents (host, urids, rnd, n, density, listen) : 0);
+		if (automation) changeControllers (host, rnd, 1 + int (rnd.rand_range (0.0f, 7.99f)));
+
+		const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+		host.run (in1.data(), in2.data(), out1.data(), out2.data(), n);
+		const std::chrono::steady_clock::time_point t1 = std::chrono::steady_clock::now();
+
+		const double ns = std::chrono::duration<double, std::nano> (t1 - t0).count();
+		nsPerSample.push_back (ns / n);
+		total += ns;
+		if (ns / n > result.max)
+		{
+			result.max = ns / n;
+			result.worstNs = ns;
+			result.worstFrames = n;
+			result.worstEvents = nEvents;
+		}
+
+		result.events += nEvents;
+		++result.blocks;
+		pos += n;
+	}
+
+	result.mean = (nframes ? total / nframes : 0.0);
+	result.p50 = percentile (nsPerSample, 0.5);
+	result.p99 = percentile (nsPerSample, 0.99);
+	result.p999 = percentile (nsPerSample, 0.999);
+	return result;
+}
+
+static void printUsage ()
+{
+	fprintf
+	(
+		stderr,
+		"Usage: bangr-stress [OPTIONS]\n"
+		"  --seconds S       Audio time per scenario in seconds (default 10)\n"
+		"  --rate R          Sample rate (default 48000)\n"
+		"  --seed N          Seed of the randomized session (default 1)\n"
+		"  --density D       Mean number of events per frame (default 0.25)\n"
+		"  --scenario NAME   Only run steady, tiny, events, automation or mixed\n"
+		"  --help            Show this help\n"
+	);
+}
+
+int main (int argc, char** argv)
+{
+	double seconds = 10.0;
+	double rate = 48000.0;
+	uint64_t seed = 1;
+	float density = 0.25f;
+	int only = -1;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if ((strcmp (argv[i], "--seconds") == 0) && (i + 1 < argc)) seconds = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--rate") == 0) && (i + 1 < argc)) rate = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--seed") == 0) && (i + 1 < argc)) seed = strtoull (argv[++i], nullptr, 10);
+		else if ((strcmp (argv[i], "--density") == 0) && (i + 1 < argc)) density = atof (argv[++i]);
+		else if ((strcmp (argv[i], "--scenario") == 0) && (i + 1 < argc))
+		{
+			const char* name = argv[++i];
+			for (int s = 0; s < NR_STRESS_SCENARIOS; ++s)
+			{
+				if (strcmp (name, scenarioNames[s]) == 0) only = s;
+			}
+			if (only < 0)
+			{
+				printUsage();
+				return 1;
+			}
+		}
+		else
+		{
+			printUsage();
+			return (strcmp (argv[i], "--help") == 0 ? 0 : 1);
+		}
+	}
+
+	if (!(seconds > 0.0) || !(rate >= 8000.0) || !(density >= 0.0f) || !(density <= 8.0f))
+	{
+		printUsage();
+		return 1;
+	}
+
+#if defined(__SSE__)
+	// As set by BAngrEngine::process() anyway, but also for the input generation
+	_mm_setcsr (_mm_getcsr() | 0x8040);
+#endif
+
+	printf ("Stress: %.0f s per scenario at %.0f Hz, seed %lu, %.2f events per frame\n\n", seconds, rate, (unsigned long) seed, density);
+	printf
+	(
+		"%-11s %9s %8s %10s %10s %10s %10s %10s %12s %8s %7s\n",
+		"scenario", "blocks", "ev/blk", "mean", "p50", "p99", "p99.9", "max", "worst [us]", "frames", "events"
+	);
+
+	for (int s = 0; s < NR_STRESS_SCENARIOS; ++s)
+	{
+		if ((only >= 0) && (s != only)) continue;
+
+		const StressResult r = runScenario (s, rate, seconds, seed, density);
+		printf
+		(
+			"%-11s %9lu %8.1f %10.2f %10.2f %10.2f %10.2f %10.2f %12.2f %8u %7u\n",
+			scenarioNames[s], (unsigned long) r.blocks, (r.blocks ? double (r.events) / r.blocks : 0.0),
+			r.mean, r.p50, r.p99, r.p999, r.max, r.worstNs * 0.001, r.worstFrames, r.worstEvents
+		);
+		fflush (stdout);
+	}
+
+	printf ("\nrun() time per sample in ns. Worst: block with the highest time per sample.\n");
+	return 0;
+}
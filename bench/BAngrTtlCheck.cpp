@@ -0,0 +1,150 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+/*
+ * Consistency check of the controller tables in ControllerLimits.hpp
+ * (symbols, defaults and limits) against the port definitions in
+ * BAngr.ttl. The tables are used by the engine, the offline host, the
+ * benchmarks and the renderer and thus must not drift from the TTL.
+ * Defaults and indexes must match. The TTL range must lie within the
+ * controller limits (the TTL may list less enumeration values).
+ *
+ * Usage: bangr-ttlcheck [TTL_FILE]
+ * Returns 1 on any difference.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include "ControllerLimits.hpp"
+#include "Ports.hpp"
+
+struct TtlPort
+{
+	int index = -1;
+	bool hasDefault = false;
+	bool hasMinimum = false;
+	bool hasMaximum = false;
+	double def = 0.0;
+	double minimum = 0.0;
+	double maximum = 0.0;
+};
+
+/*
+ * Minimal parser for the port blocks of BAngr.ttl: Collects index,
+ * default, minimum and maximum per symbol. A port block ends with a line
+ * starting with "]" (scale points are nested in one line).
+ */
+static std::map<std::string, TtlPort> parsePorts (std::istream& in)
+{
+	std::map<std::string, TtlPort> ports;
+	TtlPort port;
+	std::string symbol;
+	std::string line;
+
+	while (std::getline (in, line))
+	{
+		std::istringstream words (line);
+		std::string key;
+		words >> key;
+
+		if (key == "lv2:index") words >> port.index;
+		else if (key == "lv2:symbol")
+		{
+			const size_t a = line.find ('"');
+			const size_t b = line.find ('"', a + 1);
+			if ((a != std::string::npos) && (b != std::string::npos)) symbol = line.substr (a + 1, b - a - 1);
+		}
+		else if (key == "lv2:default") port.hasDefault = static_cast<bool> (words >> port.def);
+		else if (key == "lv2:minimum") port.hasMinimum = static_cast<bool> (words >> port.minimum);
+		else if (key == "lv2:maximum") port.hasMaximum = static_cast<bool> (words >> port.maximum);
+
+		if ((!key.empty()) && (key[0] == ']'))
+		{
+			if (!symbol.empty()) ports[symbol] = port;
+			port = TtlPort();
+			symbol.clear();
+		}
+	}
+
+	return ports;
+}
+
+static bool differs (const double a, const double b) {return fabs (a - b) > 1e-6;}
+
+int main (int argc, char** argv)
+{
+	const char* filename = (argc > 1 ? argv[1] : "BAngr.ttl");
+	if ((argc > 2) || ((argc > 1) && (strcmp (argv[1], "--help") == 0)))
+	{
+		fprintf (stderr, "Usage: bangr-ttlcheck [TTL_FILE]\n");
+		return 1;
+	}
+
+	std::ifstream file (filename);
+	if (!file)
+	{
+		fprintf (stderr, "Can't read %s.\n", filename);
+		return 1;
+	}
+	const std::map<std::string, TtlPort> ports = parsePorts (file);
+
+	int errors = 0;
+	for (int i = 0; i < NR_CONTROLLERS; ++i)
+	{
+		const std::map<std::string, TtlPort>::const_iterator it = ports.find (controllerSymbols[i]);
+		if (it == ports.end())
+		{
+			printf ("%-26s missing in %s\n", controllerSymbols[i], filename);
+			++errors;
+			continue;
+		}
+
+		const TtlPort& p = it->second;
+		const Limit& l = controllerLimits[i];
+		if (p.index != CONTROLLERS + i)
+		{
+			printf ("%-26s index %d, expected %d\n", controllerSymbols[i], p.index, CONTROLLERS + i);
+			++errors;
+		}
+		if ((!p.hasDefault) || differs (p.def, controllerDefaults[i]))
+		{
+			printf ("%-26s default %g, TTL %g\n", controllerSymbols[i], controllerDefaults[i], p.def);
+			++errors;
+		}
+		if ((!p.hasMinimum) || (p.minimum < l.min - 1e-6))
+		{
+			printf ("%-26s minimum %g, TTL %g\n", controllerSymbols[i], l.min, p.minimum);
+			++errors;
+		}
+		if ((!p.hasMaximum) || (p.maximum > l.max + 1e-6))
+		{
+			printf ("%-26s maximum %g, TTL %g\n", controllerSymbols[i], l.max, p.maximum);
+			++errors;
+		}
+	}
+
+	printf ("%d controllers checked against %s: %d difference(s)\n", NR_CONTROLLERS, filename, errors);
+	return (errors ? 1 : 0);
+}
@@ -0,0 +1,40 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef PERCENTILE_HPP_
+#define PERCENTILE_HPP_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+/*
+ * Nearest-rank percentile p in [0, 1] of the values, 0 if empty. Partially
+ * reorders the values.
+ */
+inline double percentile (std::vector<double>& values, const double p)
+{
+	if (values.empty()) return 0.0;
+	const size_t n = std::min<size_t> (values.size() - 1, size_t (p * (values.size() - 1) + 0.5));
+	std::nth_element (values.begin(), values.begin() + n, values.end());
+	return values[n];
+}
+
+#endif /* PERCENTILE_HPP_ */
@@ -0,0 +1,231 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2021 - 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include "BAngrReference.hpp"
+#include <array>
+#include <cmath>
+#include <vector>
+#include "../../src/Airwindows/XRegion.hpp"
+#include "../../src/Checkpoint.hpp"
+#include "../../src/ControllerLimits.hpp"
+
+#define LIMIT(g , min, max) ((g) > (max) ? (max) : ((g) < (min) ? (min) : (g)))
+
+static const float flexTime[NR_FLEX] = {1.0f, 0.05f, 0.05f, 0.05f, 0.05f};
+
+BAngrReference::BAngrReference (const double rate) :
+	rate (rate),
+	xcursor (0.5f),
+	ycursor (0.5f),
+	rnd (),
+	count (0),
+	fader (0.0f),
+	speed (0.0f),
+	speedrand (0.0f),
+	dspeedrand (0.0f),
+	speedflex (0.0f),
+	spin (0.0f),
+	spinrand (0.0f),
+	dspinrand (0.0f),
+	spinflex (0.0f),
+	spindir (1.0f),
+	ang (2.0 * M_PI * rnd.rand_range(-1.0f, 1.0f)),
+	speedlevel (0.0f),
+	speedmaxlevel (0.1f),
+	spinlevel (0.0f),
+	spinmaxlevel (0.1f),
+	lowpassFilter (rate, 200.0, 8),
+	highpassFilter (rate, 4000.0, 8),
+	bandpassFilter (rate, 200.0, 4000.0, 8),
+	controllers {0.0f},
+	xregion (rate)
+{
+	for (int i = 0; i < NR_CONTROLLERS; ++i) controllers[i] = controllerDefaults[i];
+}
+
+void BAngrReference::setController (const int index, const float value)
+{
+	if ((index >= 0) && (index < NR_CONTROLLERS)) controllers[index] = controllerLimits[index].validate (value);
+}
+
+void BAngrReference::seed (const uint64_t value)
+{
+	rnd.seed (value);
+	ang = 2.0 * M_PI * rnd.rand_range(-1.0f, 1.0f);
+	const uint32_t left = rnd.rand<double>() * UINT32_MAX;
+	const uint32_t right = rnd.rand<double>() * UINT32_MAX;
+
+	// Take the dither state from a seeded XRegion
+	XRegion seeded (rate);
+	seeded.seed (left, right);
+	CheckpointWriter size;
+	seeded.writeCheckpoint (size);
+	std::vector<uint8_t> snapshot (size.getPosition());
+	CheckpointWriter writer (snapshot.data(), snapshot.size());
+	seeded.writeCheckpoint (writer);
+	CheckpointReader reader (snapshot.data(), snapshot.size());
+	xregion.readCheckpoint (reader);
+}
+
+void BAngrReference::process (const float* input1, const float* input2, float* output1, float* output2, const uint32_t n)
+{
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		// Update cursor
+		if (count >= rate)
+		{
+			dspeedrand = rnd.rand_range(-1.0f, 1.0f) * controllers[SPEED_RANGE] - speedrand;
+			dspinrand = rnd.rand_range(-1.0f, 1.0f) * controllers[SPIN_RANGE] - spinrand;
+			count = 0.0;
+		}
+
+		else count++;
+
+		float dspeedflex;
+		float dspinflex;
+		const int speedtype = controllers[SPEED_TYPE];
+		const int spintype = controllers[SPIN_TYPE];
+
+		// Filter lows, mids, highs for level calculation
+		std::array<float, NR_FLEX> s;
+		s.fill (0.5f * (input1[i] + input2[i]));
+		if ((speedtype == LOWS) || (spintype == LOWS)) s[LOWS] = lowpassFilter.process (s[LOWS]);
+		if ((speedtype == MIDS) || (spintype == MIDS)) s[MIDS] = bandpassFilter.process (s[MIDS]);
+		if ((speedtype == HIGHS) || (spintype == HIGHS)) s[HIGHS] = highpassFilter.process (s[HIGHS]);
+
+		// Calculate change in speed flexibility
+		if (speedtype == RANDOM) dspeedflex = dspeedrand * (1.0f / (flexTime[speedtype] * rate));
+		else
+		{
+			// Calculate level
+			const float coeff = fabsf (s[speedtype]);
+			if (coeff >= speedmaxlevel) speedmaxlevel = coeff;
+			else speedmaxlevel = (1.0 - 1.0 / (4.0 * rate)) * speedmaxlevel;
+			if (speedmaxlevel < 0.0001f) speedmaxlevel = 0.0001f;	// Limit to -80 db to prevent div by zero
+			speedlevel = (1.0 - 1.0 / (flexTime[LEVEL] * rate)) * speedlevel + 1.0 / (flexTime[LEVEL] * rate) * (2.0 * coeff / speedmaxlevel);
+
+			dspeedflex = (2.0f * LIMIT (speedlevel, 0.0f, 1.0f) - 1.0f) * controllers[SPEED_RANGE] - speedflex;
+		}
+
+		// Calculate change in spin flexibility
+		if (spintype == RANDOM) dspinflex =  dspinrand * (1.0f / (flexTime[spintype] * rate));
+		else
+		{
+			// Calculate level
+			const float coeff = fabsf (s[spintype]);
+			if (coeff >= spinmaxlevel) spinmaxlevel = coeff;
+			else spinmaxlevel = (1.0 - 1.0 / (4.0 * rate)) * spinmaxlevel;
+			if (spinmaxlevel < 0.0001f) spinmaxlevel = 0.0001f;	// Limit to -80 db to prevent div by zero
+			const float nspinlevel = (1.0 - 1.0 / (flexTime[LEVEL] * rate)) * spinlevel + 1.0 / (flexTime[LEVEL] * rate) * (2.0 * coeff / spinmaxlevel);
+
+			if ((spinlevel >= 0.2f) && (nspinlevel < 0.2f)) spindir = (rnd.rand_range(-1.0f, 1.0f) >= 0.0f ? spindir : -spindir);
+			spinlevel = nspinlevel;
+			dspinflex = spindir * LIMIT (spinlevel, 0.0f, 1.0f) * controllers[SPIN_RANGE] - spinflex;
+		};
+
+		// Update speed
+		speedrand += (1.0f / rate) * dspeedrand;
+		speedflex += dspeedflex;
+		speed = controllers[SPEED] + controllers[SPEED_AMOUNT] * speedflex + (1.0f - controllers[SPEED_AMOUNT]) * speedrand;
+		speed = LIMIT (speed, 0.0f, 1.0f);
+
+		// Update ang
+		spinrand += (1.0f / rate) * dspinrand;
+		spinflex += dspinflex;
+		spin = controllers[SPIN] + controllers[SPIN_AMOUNT] * spinflex + (1.0f - controllers[SPIN_AMOUNT]) * spinrand;
+		spin = LIMIT (spin, -1.0f, 1.0f);
+		ang += 2.0 * M_PI * (10.0 / rate) * spin;
+		// Accepted change: Keep ang in [-pi, pi], otherwise float resolution gets lost
+		if (ang > M_PI) ang -= 2.0 * M_PI;
+		else if (ang < -M_PI) ang += 2.0 * M_PI;
+
+		// Calulate new positions
+		const float dx = sinf (ang);
+		const float dy = cosf (ang);
+		xcursor += dx * (1.0 / rate) * speed * speed;
+		ycursor += dy * (1.0 / rate) * speed * speed;
+
+		// Reflections
+		if (xcursor < 0.0f)
+		{
+			xcursor = 0.0f;
+			if (dx < 0.0f) {ang = -ang; spin = 0.0f;}
+		}
+
+		else if (xcursor > 1.0f)
+		{
+			xcursor = 1.0f;
+			if (dx > 0.0f) {ang = -ang; spin = 0.0f;}
+		}
+
+		if (ycursor < 0.0f)
+		{
+			ycursor = 0.0f;
+			if (dy < 0.0f) {ang = -M_PI - ang; spin = 0.0f;}
+		}
+
+		else if (ycursor > 1.0f)
+		{
+			ycursor = 1.0f;
+			if (dy > 0.0f) {ang = -M_PI - ang; spin = 0.0f;}
+		}
+
+		// Calculate params for cursor position
+		float params[NR_PARAMS] = {0};
+		for (int i = 0; i < NR_PARAMS; ++i)
+		{
+			params[i] =
+			(
+				((1.0f - xcursor) * (1.0f - ycursor) * controllers[FX + 0 * NR_PARAMS + i]) +
+				((1.0f - xcursor) * ycursor * controllers[FX + 1 * NR_PARAMS + i]) +
+				(xcursor * ycursor * controllers[FX + 2 * NR_PARAMS + i]) +
+				(xcursor * (1.0 - ycursor) * controllers[FX + 3 * NR_PARAMS + i])
+			);
+		}
+
+		// Update fader
+		if (fader != (1.0f - controllers[BYPASS]))
+		{
+			fader += (fader < 1.0f - controllers[BYPASS] ? 100.0 / rate : -100.0 / rate);
+			fader = LIMIT (fader, 0.0f, 1.0f);
+		}
+
+		// Set params and process
+		if (fader)
+		{
+			float in1 = input1[i];
+			float in2 = input2[i];
+			float out1 = output1[i];
+			float out2 = output2[i];
+			xregion.setParameters (params);
+			xregion.process (&in1, &in2, &out1, &out2, 1);
+
+			// Dry/wet mix
+			output1[i] = fader * controllers[DRY_WET] * out1 + (1.0f - fader * controllers[DRY_WET]) * input1[i];
+			output2[i] = fader * controllers[DRY_WET] * out2 + (1.0f - fader * controllers[DRY_WET]) * input2[i];
+		}
+
+		else
+		{
+			output1[i] = input1[i];
+			output2[i] = input2[i];
+		}
+	}
+}
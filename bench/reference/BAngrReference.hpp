@@ -0,0 +1,78 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2021 - 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BANGRREFERENCE_HPP_
+#define BANGRREFERENCE_HPP_
+
+#include <cstdint>
+#include "../../src/Ports.hpp"
+#include "../../src/RTRand.hpp"
+#include "ButterworthReference.hpp"
+#include "XRegionReference.hpp"
+
+/**
+Frozen copy of the original B.Angr DSP (per-sample cursor physics, level
+followers, parameter blending, filters and XRegion, see BAngr::play() of
+the original plugin) as reference for the numerical equivalence check of
+BAngrEngine. Do not optimize. Only adds a plain block API, seed(), which
+draws the same random values as BAngrEngine::seed(), and the accepted
+behaviour changes (marked). Controllers are applied immediately (no
+ramps).
+ */
+class BAngrReference
+{
+public:
+	BAngrReference (const double rate);
+	BAngrReference (const BAngrReference& that) = delete;
+	BAngrReference& operator= (const BAngrReference& that) = delete;
+
+	void setController (const int index, const float value);
+	void seed (const uint64_t value);
+	void process (const float* input1, const float* input2, float* output1, float* output2, const uint32_t n);
+
+private:
+	double rate;
+	float xcursor;
+	float ycursor;
+	RTRand rnd;
+	double count;
+	float fader;
+	float speed;
+	float speedrand;
+	float dspeedrand;
+	float speedflex;
+	float spin;
+	float spinrand;
+	float dspinrand;
+	float spinflex;
+	float spindir;
+	float ang;
+	float speedlevel;
+	float speedmaxlevel;
+	float spinlevel;
+	float spinmaxlevel;
+	ButterworthLowPassFilterReference lowpassFilter;
+	ButterworthHighPassFilterReference highpassFilter;
+	ButterworthBandPassFilterReference bandpassFilter;
+	float controllers[NR_CONTROLLERS];
+	XRegionReference xregion;
+};
+
+#endif /* BANGRREFERENCE_HPP_ */
@@ -0,0 +1,151 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2021 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BUTTERWORTHREFERENCE_HPP_
+#define BUTTERWORTHREFERENCE_HPP_
+
+#include <cmath>
+#include <array>
+
+#define BUTTERWORTHREFERENCE_MAXORDER 16
+
+/**
+Frozen copies of the scalar Butterworth filter implementations as
+reference for the numerical equivalence check of optimized filter
+versions. Do not optimize.
+ */
+class ButterworthFilterReference
+{
+public:
+	ButterworthFilterReference (const int order) :
+		order (order),
+		o2 (order / 2),
+		f1 (1)
+	{
+		coeff0.fill (0);
+		coeff1.fill (0);
+		coeff2.fill (0);
+		clear();
+	}
+
+	float process (const float input)
+	{
+		output = input;
+
+		for (int i = 0; i < o2; ++i)
+		{
+			buffer0[i] = buffer1[i] * coeff1[i] + buffer2[i] * coeff2[i] + output;
+			output = (buffer0[i] + buffer1[i] * f1 + buffer2[i]) * coeff0[i];
+			buffer2[i] = buffer1[i];
+			buffer1[i] = buffer0[i];
+		}
+
+		return output;
+	}
+
+	float get() const {return output;}
+
+	void clear()
+	{
+		buffer0.fill (0.0f);
+		buffer1.fill (0.0f);
+		buffer2.fill (0.0f);
+		output = 0.0f;
+	}
+
+protected:
+	int order;
+	int o2;
+	std::array <float, BUTTERWORTHREFERENCE_MAXORDER / 2> coeff0;
+	std::array <float, BUTTERWORTHREFERENCE_MAXORDER / 2> coeff1;
+	std::array <float, BUTTERWORTHREFERENCE_MAXORDER / 2> coeff2;
+	float f1;
+	std::array <float, BUTTERWORTHREFERENCE_MAXORDER / 2> buffer0;
+	std::array <float, BUTTERWORTHREFERENCE_MAXORDER / 2> buffer1;
+	std::array <float, BUTTERWORTHREFERENCE_MAXORDER / 2> buffer2;
+	float output;
+};
+
+class ButterworthLowPassFilterReference : public ButterworthFilterReference
+{
+public:
+	ButterworthLowPassFilterReference (const double rate, const double cutoff, const int order) :
+		ButterworthFilterReference (order)
+	{
+		f1 = 2;
+		const double a = tan (M_PI * cutoff / rate);
+		const double a2 = a * a;
+
+		for (int i = 0; i < o2; ++i)
+		{
+			const double r = sin (M_PI * (2.0 * double (i) + 1.0) / (2.0 * double (order)));
+			const double s = a2 + 2.0 * a * r + 1.0;
+			coeff0[i] = a2 / s;
+			coeff1[i] = 2.0 * (1.0 - a2) / s;
+			coeff2[i] = -(a2 - 2.0 * a * r + 1.0) / s;
+		}
+	}
+};
+
+class ButterworthHighPassFilterReference : public ButterworthFilterReference
+{
+public:
+	ButterworthHighPassFilterReference (const double rate, const double cutoff, const int order) :
+		ButterworthFilterReference (order)
+	{
+		f1 = -2;
+		const double a = tan (M_PI * cutoff / rate);
+		const double a2 = a * a;
+
+		for (int i = 0; i < o2; ++i)
+		{
+			const double r = sin (M_PI * (2.0 * double (i) + 1.0) / (2.0 * double (order)));
+			const double s = a2 + 2.0 * a * r + 1.0;
+			coeff0[i] = 1.0 / s;
+			coeff1[i] = 2.0 * (1.0 - a2) / s;
+			coeff2[i] = -(a2 - 2.0 * a * r + 1.0) / s;
+		}
+	}
+};
+
+class ButterworthBandPassFilterReference
+{
+public:
+	ButterworthBandPassFilterReference (const double rate, const double lowCutoff, const double highCutoff, const int order) :
+		lowpass (rate, highCutoff, order),
+		highpass (rate, lowCutoff, order)
+	{}
+
+	float process (const float input) {return highpass.process (lowpass.process (input));}
+
+	float get () const {return highpass.get();}
+
+	void clear()
+	{
+		lowpass.clear();
+		highpass.clear();
+	}
+
+protected:
+	ButterworthLowPassFilterReference lowpass;
+	ButterworthHighPassFilterReference highpass;
+};
+
+#endif /* BUTTERWORTHREFERENCE_HPP_ */
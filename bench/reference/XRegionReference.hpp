@@ -0,0 +1,70 @@
+/* ========================================
+ *  XRegion - XRegion.h
+ *  Created 8/12/11 by SPIAdmin 
+ *  Copyright (c) 2011 __MyCompanyName__, All rights reserved
+ * ======================================== */
+
+/* MIT License
+
+ Copyright (c) 2018 Chris Johnson
+ Copyright (C) 2021 Sven Jähnichen
+
+ Permission is hereby granted, free of charge, to any person obtaining a copy
+ of this software and associated documentation files (the "Software"), to deal
+ in the Software without restriction, including without limitation the rights
+ to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ copies of the Software, and to permit persons to whom the Software is
+ furnished to do so, subject to the following conditions:
+
+ The above copyright notice and this permission notice shall be included in all
+ copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ SOFTWARE.
+*/
+
+#ifndef XREGIONREFERENCE_HPP_
+#define XREGIONREFERENCE_HPP_
+
+#include <cstdint>
+#include <cmath>
+#include "../../src/Checkpoint.hpp"
+
+/**
+Frozen copy of the original XRegion implementation (coefficients are
+calculated in each process() call) as reference for the numerical
+equivalence check of optimized XRegion versions. Do not optimize. Only
+adds the DSP snapshot functions, same layout as in XRegion.
+ */
+class XRegionReference
+{
+public:
+    XRegionReference (const double rate);
+    XRegionReference (const XRegionReference& that) = delete;
+    ~XRegionReference();
+    XRegionReference& operator= (const XRegionReference& that) = delete;
+
+    void process (float* input1, float* input2, float* output1, float* output2, int32_t sampleFrames);
+	float* getParameters ();
+    void setParameters (const float* values);
+    void writeCheckpoint (CheckpointWriter& writer) const;
+    void readCheckpoint (CheckpointReader& reader);
+
+private:
+    double rate;
+    float biquad[15];
+	float biquadA[15];
+	float biquadB[15];
+	float biquadC[15];
+	float biquadD[15];
+	uint32_t fpdL;
+	uint32_t fpdR;
+    float params[6];
+};
+
+#endif /* XREGIONREFERENCE_HPP_ */
@@ -32,7 +32,8 @@
 
 XRegion::XRegion (const double rate) :
     rate (rate),
-    params {0.5f, 0.5f, 0.5f, 0.0f, 1.0f, 0.0f}
+    params {0.5f, 0.5f, 0.5f, 0.0f, 1.0f, 0.0f},
+    dirty (true)
 {
 	for (int x = 0; x < 15; x++) {biquad[x] = 0.0f; biquadA[x] = 0.0f; biquadB[x] = 0.0f; biquadC[x] = 0.0f; biquadD[x] = 0.0f;}
 	fpdL = 1.0; while (fpdL < 16386) fpdL = rand()*UINT32_MAX;
@@ -41,9 +42,9 @@ XRegion::XRegion (const double rate) :
 
 XRegion::~XRegion() {}
 
-void XRegion::process (float* input1, float* input2, float* output1, float* output2, int32_t sampleFrames)
+void XRegion::updateCoefficients ()
 {
-    float gain = powf (params[0] + 0.5f, 4);
+    gain = powf (params[0] + 0.5f, 4);
 	
 	float high = params[1];
 	float low = params[2];
@@ -53,30 +54,30 @@ void XRegion::process (float* input1, float* input2, float* output1, float* outp
 	
 	biquad[0] = high * high * high *20000.0f / rate;
 	if (biquad[0] < 0.00009f) biquad[0] = 0.00009f;
-	float compensation = sqrtf (biquad[0]) * 6.4f * spread;
-	float clipFactor = 0.75f + (biquad[0] * nuke * 37.0f);
+	compensation = sqrtf (biquad[0]) * 6.4f * spread;
+	clipFactor = 0.75f + (biquad[0] * nuke * 37.0f);
 	
     const float hm = 0.5f * (high + mid);
 	biquadA[0] = hm * hm * hm * 20000.0f / rate;
 	if (biquadA[0] < 0.00009f) biquadA[0] = 0.00009f;
-	float compensationA = sqrtf (biquadA[0]) * 6.4f * spread;
-	float clipFactorA = 0.75f + (biquadA[0] * nuke * 37.0f);
+	compensationA = sqrtf (biquadA[0]) * 6.4f * spread;
+	clipFactorA = 0.75f + (biquadA[0] * nuke * 37.0f);
 	
 	biquadB[0] = mid * mid * mid *20000.0f / rate;
 	if (biquadB[0] < 0.00009f) biquadB[0] = 0.00009f;
-	float compensationB = sqrtf (biquadB[0]) * 6.4f * spread;
-	float clipFactorB = 0.75f + (biquadB[0] * nuke * 37.0f);
+	compensationB = sqrtf (biquadB[0]) * 6.4f * spread;
+	clipFactorB = 0.75f + (biquadB[0] * nuke * 37.0f);
 	
     const float ml = 0.5f * (mid + low);
 	biquadC[0] = ml * ml * ml * 20000.0f / rate;
 	if (biquadC[0] < 0.00009f) biquadC[0] = 0.00009f;
-	float compensationC = sqrtf (biquadC[0]) * 6.4f * spread;
-	float clipFactorC = 0.75f + (biquadC[0] * nuke * 37.0f);
+	compensationC = sqrtf (biquadC[0]) * 6.4f * spread;
+	clipFactorC = 0.75f + (biquadC[0] * nuke * 37.0f);
 	
 	biquadD[0] = low * low * low * 20000.0f / rate;
 	if (biquadD[0] < 0.00009f) biquadD[0] = 0.00009f;
-	float compensationD = sqrtf (biquadD[0]) * 6.4f * spread;
-	float clipFactorD = 0.75f + (biquadD[0] * nuke * 37.0f);
+	compensationD = sqrtf (biquadD[0]) * 6.4f * spread;
+	clipFactorD = 0.75f + (biquadD[0] * nuke * 37.0f);
 	
 	float K = tanf (M_PI * biquad[0]);
 	float norm = 1.0f / (1.0f + K / 0.7071f + K * K);
@@ -113,12 +114,12 @@ void XRegion::process (float* input1, float* input2, float* output1, float* outp
 	biquadD[5] = 2.0f * (K * K - 1.0f) * norm;
 	biquadD[6] = (1.0f - K / 0.7071f + K * K) * norm;	
 	
-	float aWet = 1.0f;
-	float bWet = 1.0f;
-	float cWet = 1.0f;
-	float dWet = params[3] * 4.0f;
-	float wet = params[4];
-    float pan = params[5];
+	aWet = 1.0f;
+	bWet = 1.0f;
+	cWet = 1.0f;
+	dWet = params[3] * 4.0f;
+	wet = params[4];
+    pan = params[5];
 	
 	//four-stage wet/dry control using progressive stages that bypass when not engaged
 	if (dWet < 1.0f) {aWet = dWet; bWet = 0.0f; cWet = 0.0f; dWet = 0.0f;}
@@ -129,6 +130,32 @@ void XRegion::process (float* input1, float* input2, float* output1, float* outp
 	//output as the control is turned up. Each one independently goes from 0-1 and stays at 1
 	//beyond that point: this is a way to progressively add a 'black box' sound processing
 	//which lets you fall through to simpler processing at lower settings.
+
+    dirty = false;
+}
+
+void XRegion::process (float* input1, float* input2, float* output1, float* output2, int32_t sampleFrames)
+{
+    if (dirty) updateCoefficients ();
+
+    // Local copies of the coefficients, members may alias with the buffers
+    const float gain = this->gain;
+    const float compensation = this->compensation;
+    const float compensationA = this->compensationA;
+    const float compensationB = this->compensationB;
+    const float compensationC = this->compensationC;
+    const float compensationD = this->compensationD;
+    const float clipFactor = this->clipFactor;
+    const float clipFactorA = this->clipFactorA;
+    const float clipFactorB = this->clipFactorB;
+    const float clipFactorC = this->clipFactorC;
+    const float clipFactorD = this->clipFactorD;
+    const float aWet = this->aWet;
+    const float bWet = this->bWet;
+    const float cWet = this->cWet;
+    const float dWet = this->dWet;
+    const float wet = this->wet;
+    const float pan = this->pan;
 	float outSample = 0.0f;
 	
     while (--sampleFrames >= 0)
@@ -275,7 +302,52 @@ void XRegion::process (float* input1, float* input2, float* output1, float* outp
 
 void XRegion::setParameters (const float* values) 
 {
+    if (memcmp (params, values, 6 * sizeof (float)) == 0) return;
     memcpy (params, values, 6 * sizeof (float));
+    dirty = true;
 }
 
 float* XRegion::getParameters () {return params;}
+
+void XRegion::prepare ()
+{
+    if (dirty) updateCoefficients ();
+}
+
+void XRegion::setRate (const double rate)
+{
+    this->rate = rate;
+    dirty = true;
+}
+
+void XRegion::seed (const uint32_t left, const uint32_t right)
+{
+    // Dither states must not be too small (see constructor)
+    fpdL = (left < 16386 ? left + 16386 : left);
+    fpdR = (right < 16386 ? right + 16386 : right);
+}
+
+void XRegion::writeCheckpoint (CheckpointWriter& writer) const
+{
+    writer.put (biquad, 15);
+    writer.put (biquadA, 15);
+    writer.put (biquadB, 15);
+    writer.put (biquadC, 15);
+    writer.put (biquadD, 15);
+    writer.put (fpdL);
+    writer.put (fpdR);
+    writer.put (params, 6);
+}
+
+void XRegion::readCheckpoint (CheckpointReader& reader)
+{
+    reader.get (biquad, 15);
+    reader.get (biquadA, 15);
+    reader.get (biquadB, 15);
+    reader.get (biquadC, 15);
+    reader.get (biquadD, 15);
+    reader.get (fpdL);
+    reader.get (fpdR);
+    reader.get (params, 6);
+    dirty = true;
+}
@@ -33,6 +33,7 @@
 
 #include <cstdint>
 #include <cmath>
+#include "../Checkpoint.hpp"
 
 
 class XRegion
@@ -46,6 +47,11 @@ public:
     void process (float* input1, float* input2, float* output1, float* output2, int32_t sampleFrames);
 	float* getParameters ();
     void setParameters (const float* values);
+    void prepare ();
+    void setRate (const double rate);
+    void seed (const uint32_t left, const uint32_t right);
+    void writeCheckpoint (CheckpointWriter& writer) const;
+    void readCheckpoint (CheckpointReader& reader);
 
 private:
     double rate;
@@ -57,6 +63,28 @@ private:
 	uint32_t fpdL;
 	uint32_t fpdR;
     float params[6];
+    bool dirty;
+
+    // Coefficients, updated on parameter change
+    float gain;
+    float compensation;
+    float compensationA;
+    float compensationB;
+    float compensationC;
+    float compensationD;
+    float clipFactor;
+    float clipFactorA;
+    float clipFactorB;
+    float clipFactorC;
+    float clipFactorD;
+    float aWet;
+    float bWet;
+    float cWet;
+    float dWet;
+    float wet;
+    float pan;
+
+    void updateCoefficients ();
 };
 
 #endif /* XREGION_HPP_ */
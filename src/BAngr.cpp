@@ -21,48 +21,47 @@
 #include "BAngr.hpp"
 
 #include <cstdio>
+#include <algorithm>
 #include <stdexcept>
-#include "ControllerLimits.hpp"
+#include <vector>
+#include "CursorMessage.hpp"
+#include "Trace.hpp"
 
 #define LIMIT(g , min, max) ((g) > (max) ? (max) : ((g) < (min) ? (min) : (g)))
 
-const float flexTime[NR_FLEX] = {1.0f, 0.05f, 0.05f, 0.05f, 0.05f};
+const float defaultNotifyRate = 20.0f;
 
 BAngr::BAngr (double samplerate, const LV2_Feature* const* features) :
 	map(NULL),
+	telemetry (),
 	rate (samplerate),
-	xcursor (0.5f),
-	ycursor (0.5f),
-	listen (false),
-	rnd (), 
-	count (0),
-	fader (0.0f),
-	speed (0.0f),
-	speedrand (0.0f),
-	dspeedrand (0.0f),
-	speedflex (0.0f),
-	spin (0.0f),
-	spinrand (0.0f),
-	dspinrand (0.0f),
-	spinflex (0.0f),
-	spindir (1.0f),
-	ang (2.0 * M_PI * rnd.rand_range(-1.0f, 1.0f)),
-	speedlevel (0.0f),
-	speedmaxlevel (0.1f),
-	spinlevel (0.0f),
-	spinmaxlevel (0.1f),
-	lowpassFilter (rate, 200.0, 8),
-	highpassFilter (rate, 4000.0, 8),
-	bandpassFilter (rate, 200.0, 4000.0, 8),
+	uiCount (0),
+	notifyRate (defaultNotifyRate),
+	notifyCount (0.0),
+	notifyForced (true),
+	notifiedXCursor (0.5f),
+	notifiedYCursor (0.5f),
+	notifiedXVelocity (0.0f),
+	notifiedYVelocity (0.0f),
+	trail {0},
+	trailWritten (0),
+	trailSent (0),
+	trailCount (0.0),
 	controlPort (nullptr),
 	notifyPort (nullptr),
 	audioInput1 (nullptr), 
 	audioInput2 (nullptr),
 	audioOutput1 (nullptr), 
 	audioOutput2 (nullptr),
+	dspLoadPort (nullptr),
+	dspPeakPort (nullptr),
+	seedPort (nullptr),
+	seedPortValue (0.0f),
+	seedPortSync (false),
+	seedValue (0),
 	newControllers {nullptr},
-	controllers {0.0f},
-	xregion (samplerate)
+	engine (samplerate),
+	dspLoad (samplerate)
 
 {
 	//Scan host features for URID map
@@ -108,6 +107,15 @@ void BAngr::connect_port(uint32_t port, void *data)
 	case AUDIO_OUT_2:
 		audioOutput2 = (float*) data;
 		break;
+	case DSP_LOAD:
+		dspLoadPort = (float*) data;
+		break;
+	case DSP_PEAK:
+		dspPeakPort = (float*) data;
+		break;
+	case SEED:
+		seedPort = (float*) data;
+		break;
 	default:
 		if ((port >= CONTROLLERS) && (port < CONTROLLERS + NR_CONTROLLERS)) newControllers[port - CONTROLLERS] = (float*) data;
 	}
@@ -122,11 +130,20 @@ void BAngr::run (uint32_t n_samples)
 		if (!newControllers[i]) return;
 	}
 
-	// Update controller values
-	for (int i = 0; i < NR_CONTROLLERS; ++i)
+	dspLoad.begin ();
+	TRACE_BEGIN (engine.getTracer());
+
+	// Re-seed on seed port changes (0: random). After state restore, only
+	// take over the port value and keep the restored seed.
+	if (seedPort && (*seedPort != seedPortValue))
 	{
-		if (controllers[i] != *newControllers[i]) controllers[i] = controllerLimits[i].validate (*newControllers[i]);
+		seedPortValue = *seedPort;
+		if (!seedPortSync) seed (seedPortValue >= 1.0f ? uint64_t (seedPortValue) : 0);
 	}
+	seedPortSync = false;
+
+	// Pass controller ports, the engine only applies changed values
+	for (int i = 0; i < NR_CONTROLLERS; ++i) engine.setController (i, *newControllers[i]);
 
 	// Prepare forge buffer and initialize atom sequence
 	const uint32_t space = notifyPort->atom.size;
@@ -141,8 +158,45 @@ void BAngr::run (uint32_t n_samples)
 		{
 			const LV2_Atom_Object* obj = (const LV2_Atom_Object*)&ev->body;
 
-			if (obj->body.otype == urids.bangr_cursorOn) listen = true;
-			else if (obj->body.otype == urids.bangr_cursorOff) listen = false;
+			if (obj->body.otype == urids.bangr_cursorOn) engine.setListen (true);
+			else if (obj->body.otype == urids.bangr_cursorOff) engine.setListen (false);
+
+			// Count open GUIs, notify as long as at least one is open
+			else if (obj->body.otype == urids.bangr_uiOn)
+			{
+				if (uiCount == 0)
+				{
+					trailSent = trailWritten;	// Drop trail points recorded for a former GUI
+					trailCount = 0.0;
+				}
+				++uiCount;
+				notifyForced = true;
+			}
+
+			else if (obj->body.otype == urids.bangr_uiOff)
+			{
+				if (uiCount > 0) --uiCount;
+			}
+
+			// Combined cursor message from GUI
+			else if (obj->body.otype == urids.bangr_cursor)
+			{
+				const LV2_Atom* xAtom = NULL;
+				const LV2_Atom* yAtom = NULL;
+				const LV2_Atom* listenAtom = NULL;
+				lv2_atom_object_get
+				(
+					obj,
+					urids.bangr_xcursor, &xAtom,
+					urids.bangr_ycursor, &yAtom,
+					urids.bangr_listen, &listenAtom,
+					NULL
+				);
+
+				if (xAtom && (xAtom->type == urids.atom_Float)) engine.setXCursor (((LV2_Atom_Float*)xAtom)->body);
+				if (yAtom && (yAtom->type == urids.atom_Float)) engine.setYCursor (((LV2_Atom_Float*)yAtom)->body);
+				if (listenAtom && (listenAtom->type == urids.atom_Bool)) engine.setListen (((LV2_Atom_Bool*)listenAtom)->body);
+			}
 
 			else if (obj->body.otype == urids.patch_Set)
 			{
@@ -160,211 +214,151 @@ void BAngr::run (uint32_t n_samples)
 				{
 					const uint32_t key = ((const LV2_Atom_URID*)property)->body;
 					
-					if ((key == urids.bangr_xcursor) && (value->type == urids.atom_Float)) xcursor = ((LV2_Atom_Float*)value)->body;
-					else if ((key == urids.bangr_ycursor) && (value->type == urids.atom_Float)) ycursor = ((LV2_Atom_Float*)value)->body;
+					if ((key == urids.bangr_xcursor) && (value->type == urids.atom_Float)) engine.setXCursor (((LV2_Atom_Float*)value)->body);
+					else if ((key == urids.bangr_ycursor) && (value->type == urids.atom_Float)) engine.setYCursor (((LV2_Atom_Float*)value)->body);
+					else if ((key == urids.bangr_notifyRate) && (value->type == urids.atom_Float)) setNotifyRate (((LV2_Atom_Float*)value)->body);
 				}
 			}
 
 			// Play samples
 			uint32_t next_t = (ev->time.frames < n_samples ? ev->time.frames : n_samples);
-			play (last_t, next_t);
+			TRACE_LAP (engine.getTracer(), TRACE_EVENTS);
+			engine.process (&audioInput1[last_t], &audioInput2[last_t], &audioOutput1[last_t], &audioOutput2[last_t], next_t - last_t);
 			last_t = next_t;
 		}
 	}
 
 	// Play remaining samples
-	if (last_t < n_samples) play (last_t, n_samples);		
-
-	// Send collected data to GUI
-	if (!listen) notifyCursor ();
+	TRACE_LAP (engine.getTracer(), TRACE_EVENTS);
+	if (last_t < n_samples) engine.process (&audioInput1[last_t], &audioInput2[last_t], &audioOutput1[last_t], &audioOutput2[last_t], n_samples - last_t);
+
+	// Send collected data to GUI: Directly via telemetry ring (see below)
+	// if attached, otherwise via atom messages, but not more often than
+	// notifyRate. Other GUIs than the attached one use atom messages too.
+	const bool attached = telemetry.attached.load (std::memory_order_acquire);
+	if (uiCount > (attached ? 1u : 0u))
+	{
+		recordTrail (n_samples);
+		notifyCount += n_samples;
+		if ((!engine.getListen ()) && (notifyForced || (notifyCount * notifyRate >= rate)))
+		{
+			notifyCursor ();
+			notifyTrail ();
+			notifyCount = 0.0;
+		}
+	}
 
 	// Close off sequence
 	lv2_atom_forge_pop (&forge, &frame);
-}
+	TRACE_LAP (engine.getTracer(), TRACE_EVENTS);
+	TRACE_END (engine.getTracer(), n_samples);
 
-void BAngr::play (const uint32_t start, const uint32_t end)
-{
-	for (uint32_t i = start; i < end; ++i)
+	// Publish DSP load (optional output ports)
+	dspLoad.end (n_samples);
+	if (dspLoadPort) *dspLoadPort = dspLoad.getLoad ();
+	if (dspPeakPort) *dspPeakPort = dspLoad.getPeak ();
+
+	// Telemetry including the load statistics of this block
+	if (attached)
 	{
-		// Update cursor
-		if (!listen)
-		{
-			if (count >= rate)
+		const BAngrModulation m = engine.getModulation ();
+		telemetry.ring.push
+		(
+			TelemetrySample
 			{
-				dspeedrand = rnd.rand_range(-1.0f, 1.0f) * controllers[SPEED_RANGE] - speedrand;
-				dspinrand = rnd.rand_range(-1.0f, 1.0f) * controllers[SPIN_RANGE] - spinrand;
-				count = 0.0;
+				n_samples, m.xcursor, m.ycursor, m.speed, m.spin, m.speedlevel, m.spinlevel,
+				dspLoad.getLoad (), dspLoad.getPeak ()
 			}
+		);
+	}
+}
 
-			else count++;
-
-			float dspeedflex;
-			float dspinflex;
-			const int speedtype = controllers[SPEED_TYPE];
-			const int spintype = controllers[SPIN_TYPE];
-
-			// Filter lows, mids, highs for level calculation
-			std::array<float, NR_FLEX> s;
-			s.fill (0.5f * (audioInput1[i] + audioInput2[i]));
-			if ((speedtype == LOWS) || (spintype == LOWS)) s[LOWS] = lowpassFilter.process (s[LOWS]);
-			if ((speedtype == MIDS) || (spintype == MIDS)) s[MIDS] = bandpassFilter.process (s[MIDS]);
-			if ((speedtype == HIGHS) || (spintype == HIGHS)) s[HIGHS] = highpassFilter.process (s[HIGHS]);
-
-			// Calculate change in speed flexibility
-			if (speedtype == RANDOM) dspeedflex = dspeedrand * (1.0f / (flexTime[speedtype] * rate));
-			else 
-			{
-				// Calculate level
-				const float coeff = fabsf (s[speedtype]);
-				if (coeff >= speedmaxlevel) speedmaxlevel = coeff;
-				else speedmaxlevel = (1.0 - 1.0 / (4.0 * rate)) * speedmaxlevel;
-				if (speedmaxlevel < 0.0001f) speedmaxlevel = 0.0001f;	// Limit to -80 db to prevent div by zero
-				speedlevel = (1.0 - 1.0 / (flexTime[LEVEL] * rate)) * speedlevel + 1.0 / (flexTime[LEVEL] * rate) * (2.0 * coeff / speedmaxlevel);
-
-				dspeedflex = (2.0f * LIMIT (speedlevel, 0.0f, 1.0f) - 1.0f) * controllers[SPEED_RANGE] - speedflex;
-
-				// Command line meter (for debugging)
-				/*
-				if (int(count) % 1000 == 0) 
-				{
-					char s[41];
-					memset (s, ' ', 40);
-					int x = int (40 * LIMIT (speedlevel, 0.0f, 1.0f));
-					memset (s, '.', x);
-					s[40] = 0;
-					fprintf (stderr, "\r%s", s);
-				}
-				*/
-			}
+void BAngr::notifyCursor()
+{
+	// Only send the changed coordinates. The velocity is sent with each
+	// message (and once if the cursor stops) to let the GUI extrapolate.
+	const BAngrModulation m = engine.getModulation ();
+	const bool xchanged = notifyForced || (m.xcursor != notifiedXCursor);
+	const bool ychanged = notifyForced || (m.ycursor != notifiedYCursor);
+	const bool vchanged = notifyForced || (m.xvelocity != notifiedXVelocity) || (m.yvelocity != notifiedYVelocity);
+	if (!(xchanged || ychanged || vchanged)) return;
+
+	if (!forgeCursor (&forge, urids, 0, xchanged, m.xcursor, ychanged, m.ycursor, true, m.xvelocity, m.yvelocity)) return;
+
+	notifiedXCursor = m.xcursor;
+	notifiedYCursor = m.ycursor;
+	notifiedXVelocity = m.xvelocity;
+	notifiedYVelocity = m.yvelocity;
+	notifyForced = false;
+}
 
-			// Calculate change in spin flexibility
-			if (spintype == RANDOM) dspinflex =  dspinrand * (1.0f / (flexTime[spintype] * rate));
-			else
-			{
-				// Calculate level
-				const float coeff = fabsf (s[spintype]);
-				if (coeff >= spinmaxlevel) spinmaxlevel = coeff;
-				else spinmaxlevel = (1.0 - 1.0 / (4.0 * rate)) * spinmaxlevel;
-				if (spinmaxlevel < 0.0001f) spinmaxlevel = 0.0001f;	// Limit to -80 db to prevent div by zero
-				const float nspinlevel = (1.0 - 1.0 / (flexTime[LEVEL] * rate)) * spinlevel + 1.0 / (flexTime[LEVEL] * rate) * (2.0 * coeff / spinmaxlevel);
-
-				if ((spinlevel >= 0.2f) && (nspinlevel < 0.2f)) spindir = (rnd.rand_range(-1.0f, 1.0f) >= 0.0f ? spindir : -spindir);
-				spinlevel = nspinlevel;
-				dspinflex = spindir * LIMIT (spinlevel, 0.0f, 1.0f) * controllers[SPIN_RANGE] - spinflex;
-			}; 
-
-			// Update speed
-			speedrand += (1.0f / rate) * dspeedrand;
-			speedflex += dspeedflex;
-			speed = controllers[SPEED] + controllers[SPEED_AMOUNT] * speedflex + (1.0f - controllers[SPEED_AMOUNT]) * speedrand;
-			speed = LIMIT (speed, 0.0f, 1.0f);
-
-			// Update ang
-			spinrand += (1.0f / rate) * dspinrand;
-			spinflex += dspinflex;
-			spin = controllers[SPIN] + controllers[SPIN_AMOUNT] * spinflex + (1.0f - controllers[SPIN_AMOUNT]) * spinrand;
-			spin = LIMIT (spin, -1.0f, 1.0f);
-			ang += 2.0 * M_PI * (10.0 / rate) * spin;
-
-			// Calulate new positions
-			const float dx = sinf (ang);
-			const float dy = cosf (ang);
-			xcursor += dx * (1.0 / rate) * speed * speed;
-			ycursor += dy * (1.0 / rate) * speed * speed;
-
-			// Reflections
-			if (xcursor < 0.0f)
-			{
-				xcursor = 0.0f;
-				if (dx < 0.0f) {ang = -ang; spin = 0.0f;}
-			}
+void BAngr::recordTrail (const uint32_t n_samples)
+{
+	// Block end position once per trail interval, no per-sample cost
+	const double interval = rate / BANGR_TRAIL_RATE;
+	trailCount += n_samples;
+	if (trailCount < interval) return;
+
+	const BAngrModulation m = engine.getModulation ();
+	const uint32_t point = packTrailPoint (m.xcursor, m.ycursor);
+	for (int i = 0; (trailCount >= interval) && (i < BANGR_TRAIL_SIZE); ++i)
+	{
+		trail[trailWritten & (BANGR_TRAIL_SIZE - 1)] = point;
+		++trailWritten;
+		trailCount -= interval;
+	}
+	if (trailCount >= interval) trailCount = 0.0;
+}
 
-			else if (xcursor > 1.0f)
-			{
-				xcursor = 1.0f;
-				if (dx > 0.0f) {ang = -ang; spin = 0.0f;}
-			}
+void BAngr::notifyTrail ()
+{
+	// All new points, limited to the ring size
+	if (trailWritten - trailSent > BANGR_TRAIL_SIZE) trailSent = trailWritten - BANGR_TRAIL_SIZE;
+	const uint32_t n = trailWritten - trailSent;
+	if (n == 0) return;
 
-			if (ycursor < 0.0f)
-			{
-				ycursor = 0.0f;
-				if (dy < 0.0f) {ang = -M_PI - ang; spin = 0.0f;}
-			}
+	uint32_t points[BANGR_TRAIL_SIZE];
+	for (uint32_t i = 0; i < n; ++i) points[i] = trail[(trailSent + i) & (BANGR_TRAIL_SIZE - 1)];
+	if (!forgeTrail (&forge, urids, 0, points, n)) return;
 
-			else if (ycursor > 1.0f)
-			{
-				ycursor = 1.0f;
-				if (dy > 0.0f) {ang = -M_PI - ang; spin = 0.0f;}
-			}
-		}
+	trailSent = trailWritten;
+}
 
-		// Calculate params for cursor position
-		float params[NR_PARAMS] = {0};
-		for (int i = 0; i < NR_PARAMS; ++i)
-		{
-			params[i] =
-			(
-				((1.0f - xcursor) * (1.0f - ycursor) * controllers[FX + 0 * NR_PARAMS + i]) +
-				((1.0f - xcursor) * ycursor * controllers[FX + 1 * NR_PARAMS + i]) +
-				(xcursor * ycursor * controllers[FX + 2 * NR_PARAMS + i]) +
-				(xcursor * (1.0 - ycursor) * controllers[FX + 3 * NR_PARAMS + i])
-			);
-		}
+void BAngr::setNotifyRate (const float hz)
+{
+	if (!std::isnan (hz)) notifyRate = LIMIT (hz, 1.0f, 120.0f);
+}
 
-		// Update fader
-		if (fader != (1.0f - controllers[BYPASS]))
-		{
-			fader += (fader < 1.0f - controllers[BYPASS] ? 100.0 / rate : -100.0 / rate);
-			fader = LIMIT (fader, 0.0f, 1.0f);
-		}
+void BAngr::seed (const uint64_t value)
+{
+	seedValue = value;
+	if (value) engine.seed (value);
+}
 
-		// Set params and process
-		if (fader)
-		{
-			float out1 = audioOutput1[i];
-			float out2 = audioOutput2[i];
-			xregion.setParameters (params);
-			xregion.process (&audioInput1[i], &audioInput2[i], &out1, &out2, 1);
-
-			// Dry/wet mix
-			audioOutput1[i] = fader * controllers[DRY_WET] * out1 + (1.0f - fader * controllers[DRY_WET]) * audioInput1[i];
-			audioOutput2[i] = fader * controllers[DRY_WET] * out2 + (1.0f - fader * controllers[DRY_WET]) * audioInput2[i];
-		}
+uint64_t BAngr::getSeed () const {return seedValue;}
 
-		else
-		{
-			audioOutput1[i] = audioInput1[i];
-			audioOutput2[i] = audioInput2[i];
+size_t BAngr::getCheckpointSize () const {return engine.getCheckpointSize ();}
 
-		}
-	}
-}
+size_t BAngr::saveCheckpoint (uint8_t* data, const size_t size) const {return engine.saveCheckpoint (data, size);}
 
-void BAngr::notifyCursor()
-{
-	LV2_Atom_Forge_Frame frame;
-	lv2_atom_forge_frame_time(&forge, 0);
-	lv2_atom_forge_object(&forge, &frame, 0, urids.patch_Set);
-	lv2_atom_forge_key(&forge, urids.patch_property);
-	lv2_atom_forge_urid(&forge, urids.bangr_xcursor);
-	lv2_atom_forge_key(&forge, urids.patch_value);
-	lv2_atom_forge_float(&forge, xcursor);
-	lv2_atom_forge_pop(&forge, &frame);
-
-	lv2_atom_forge_frame_time(&forge, 0);
-	lv2_atom_forge_object(&forge, &frame, 0, urids.patch_Set);
-	lv2_atom_forge_key(&forge, urids.patch_property);
-	lv2_atom_forge_urid(&forge, urids.bangr_ycursor);
-	lv2_atom_forge_key(&forge, urids.patch_value);
-	lv2_atom_forge_float(&forge, ycursor);
-	lv2_atom_forge_pop(&forge, &frame);
-}
+bool BAngr::restoreCheckpoint (const uint8_t* data, const size_t size) {return engine.restoreCheckpoint (data, size);}
 
 LV2_State_Status BAngr::state_save (LV2_State_Store_Function store, LV2_State_Handle handle, uint32_t flags,
 			const LV2_Feature* const* features)
 {
-	store (handle, urids.bangr_xcursor, &xcursor, sizeof (float), urids.atom_Float, LV2_STATE_IS_POD);
-	store (handle, urids.bangr_ycursor, &ycursor, sizeof (float), urids.atom_Float, LV2_STATE_IS_POD);
+	const BAngrModulation m = engine.getModulation ();
+	store (handle, urids.bangr_xcursor, &m.xcursor, sizeof (float), urids.atom_Float, LV2_STATE_IS_POD);
+	store (handle, urids.bangr_ycursor, &m.ycursor, sizeof (float), urids.atom_Float, LV2_STATE_IS_POD);
+	const int64_t seedData = seedValue;
+	store (handle, urids.bangr_seed, &seedData, sizeof (int64_t), urids.atom_Long, LV2_STATE_IS_POD);
+
+	// Complete DSP snapshot (native byte order, thus not portable)
+	std::vector<uint8_t> checkpoint (getCheckpointSize());
+	if (saveCheckpoint (checkpoint.data(), checkpoint.size()))
+	{
+		store (handle, urids.bangr_checkpoint, checkpoint.data(), checkpoint.size(), urids.atom_Chunk, LV2_STATE_IS_POD);
+	}
+
 	return LV2_STATE_SUCCESS;
 }
 
@@ -375,11 +369,25 @@ LV2_State_Status BAngr::state_restore (LV2_State_Retrieve_Function retrieve, LV2
 	uint32_t type;
 	uint32_t valflags;
 
+	// Complete DSP snapshot first, cursor properties may override
+	const void* checkpointData = retrieve(handle, urids.bangr_checkpoint, &size, &type, &valflags);
+	const bool restored = checkpointData && (type == urids.atom_Chunk) && restoreCheckpoint (static_cast<const uint8_t*>(checkpointData), size);
+
+	// Seed, the random sources are already part of a restored snapshot
+	const void* seedData = retrieve(handle, urids.bangr_seed, &size, &type, &valflags);
+	if (seedData && (type == urids.atom_Long))
+	{
+		const uint64_t value = *(const int64_t*)seedData;
+		if (restored) seedValue = value;
+		else seed (value);
+		seedPortSync = true;
+	}
+
 	const void* xcursorData = retrieve(handle, urids.bangr_xcursor, &size, &type, &valflags);
-	if (xcursorData && (type == urids.atom_Float)) xcursor = LIMIT (*(const float*)xcursorData, 0.0f, 1.0f);
+	if (xcursorData && (type == urids.atom_Float)) engine.setXCursor (*(const float*)xcursorData);
 
 	const void* ycursorData = retrieve(handle, urids.bangr_ycursor, &size, &type, &valflags);
-	if (ycursorData && (type == urids.atom_Float)) ycursor = LIMIT (*(const float*)ycursorData, 0.0f, 1.0f);
+	if (ycursorData && (type == urids.atom_Float)) engine.setYCursor (*(const float*)ycursorData);
 
 	return LV2_STATE_SUCCESS;
 }
@@ -441,10 +449,18 @@ static LV2_State_Status state_restore(LV2_Handle instance, LV2_State_Retrieve_Fu
 	return LV2_STATE_SUCCESS;
 }
 
+static BAngrTelemetry* getTelemetry (LV2_Handle instance)
+{
+	BAngr* inst = (BAngr*)instance;
+	return (inst ? &inst->telemetry : NULL);
+}
+
 static const void* extension_data(const char* uri)
 {
 	static const LV2_State_Interface  state  = {state_save, state_restore};
+	static const BAngrTelemetryInterface telemetry = {getTelemetry};
 	if (!strcmp(uri, LV2_STATE__interface)) return &state;
+	if (!strcmp(uri, BANGR_TELEMETRY_URI)) return &telemetry;
 	return NULL;
 }
 
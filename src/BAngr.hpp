@@ -22,6 +22,7 @@
 #define BANGR_HPP_
 
 #include <cmath>
+#include <array>
 #include <lv2/core/lv2.h>
 #include <lv2/urid/urid.h>
 #include <lv2/atom/atom.h>
@@ -29,14 +30,15 @@
 #include <lv2/state/state.h>
 
 #include "Ports.hpp"
-#include "RTRand.hpp"
 #include "Urids.hpp"
-#include "Airwindows/XRegion.hpp"
-#include "ButterworthLowPassFilter.hpp"
-#include "ButterworthHighPassFilter.hpp"
-#include "ButterworthBandPassFilter.hpp"
-
+#include "Telemetry.hpp"
+#include "DspLoad.hpp"
+#include "BAngrEngine.hpp"
 
+/**
+LV2 adapter of the B.Angr DSP. Translates ports, atom messages and state
+into calls of BAngrEngine and sends notifications to the GUI.
+ */
 class BAngr
 {
 public:
@@ -48,33 +50,74 @@ public:
 	LV2_State_Status state_save(LV2_State_Store_Function store, LV2_State_Handle handle, uint32_t flags, const LV2_Feature* const* features);
 	LV2_State_Status state_restore(LV2_State_Retrieve_Function retrieve, LV2_State_Handle handle, uint32_t flags, const LV2_Feature* const* features);
 
+	/**
+	Gets the size of a complete DSP snapshot.
+	@return	Size in bytes.
+	 */
+	size_t getCheckpointSize () const;
+
+	/**
+	Writes a versioned binary snapshot of the complete DSP state (cursor,
+	random generator, modulation integrators, level followers, filter
+	buffers, XRegion histories and validated controllers).
+	@param data	Target buffer.
+	@param size	Size of the target buffer.
+	@return		Number of bytes written, or 0 if the buffer is too small.
+	 */
+	size_t saveCheckpoint (uint8_t* data, const size_t size) const;
+
+	/**
+	Restores the complete DSP state from a snapshot of the same version
+	taken at the same sample rate. Restoring and processing yields sample-
+	identical output to the instance the snapshot was taken from.
+	@param data	Snapshot data.
+	@param size	Size of the snapshot data.
+	@return		True on success, otherwise false and the DSP state remains
+			unchanged.
+	 */
+	bool restoreCheckpoint (const uint8_t* data, const size_t size);
+
+	/**
+	Sets the maximum rate of cursor notifications sent to the GUI.
+	@param hz	Notification rate in Hz, limited to [1, 120].
+	 */
+	void setNotifyRate (const float hz);
+
+	/**
+	Re-seeds all random sources of the DSP (random generator, initial
+	cursor angle and XRegion dither). Instances seeded with the same
+	value and fed with the same input and controllers produce identical
+	output. Must not be called concurrently to run(). The seed is stored
+	with the plugin state.
+	@param value	Seed, 0 leaves the random sources unseeded.
+	 */
+	void seed (const uint64_t value);
+
+	/**
+	Gets the last applied seed.
+	@return	Seed or 0 if unseeded.
+	 */
+	uint64_t getSeed () const;
+
 	LV2_URID_Map* map;
+	BAngrTelemetry telemetry;
 
 private:
 	double rate;
-	float xcursor;
-	float ycursor;
-	bool listen;
-	RTRand rnd;
-	double count;
-	float fader;
-	float speed;
-	float speedrand;
-	float dspeedrand;
-	float speedflex;
-	float spin;
-	float spinrand;
-	float dspinrand;
-	float spinflex;
-	float spindir;
-	float ang;
-	float speedlevel;
-	float speedmaxlevel;
-	float spinlevel;
-	float spinmaxlevel;
-	ButterworthLowPassFilter lowpassFilter;
-	ButterworthHighPassFilter highpassFilter;
-	ButterworthBandPassFilter bandpassFilter;
+	uint32_t uiCount;
+	float notifyRate;
+	double notifyCount;
+	bool notifyForced;
+	float notifiedXCursor;
+	float notifiedYCursor;
+	float notifiedXVelocity;
+	float notifiedYVelocity;
+
+	// Cursor trail ring, recorded at block ends with BANGR_TRAIL_RATE
+	std::array<uint32_t, BANGR_TRAIL_SIZE> trail;
+	uint64_t trailWritten;
+	uint64_t trailSent;
+	double trailCount;
 
 	// Control ports
 	LV2_Atom_Sequence* controlPort;
@@ -86,9 +129,19 @@ private:
 	float* audioOutput1;
 	float* audioOutput2;
 
+	// DSP load output ports
+	float* dspLoadPort;
+	float* dspPeakPort;
+
+	// Seed port, applied on change. seedPortValue is the last port value,
+	// seedValue the active seed (port, API or restored state).
+	float* seedPort;
+	float seedPortValue;
+	bool seedPortSync;
+	uint64_t seedValue;
+
 	// Controllers
 	float* newControllers[NR_CONTROLLERS];
-	float controllers[NR_CONTROLLERS];
 
 	// Urids
 	BAngrURIs urids;
@@ -96,10 +149,12 @@ private:
 	// Internals
 	LV2_Atom_Forge forge;
 	LV2_Atom_Forge_Frame frame;
-	XRegion xregion;
+	BAngrEngine engine;
+	DspLoad dspLoad;
 
-	void play (const uint32_t start, const uint32_t end);
 	void notifyCursor();
+	void recordTrail (const uint32_t n_samples);
+	void notifyTrail ();
 
 };
 
@@ -21,6 +21,7 @@
 #define BANGRDIAL_HPP_
 
 #include "BWidgets/BWidgets/ValueDial.hpp"
+#include "LayerCache.hpp"
 
 class BAngrDial : public BWidgets::ValueDial
 {
@@ -45,9 +46,15 @@ protected:
 	virtual void drawArc (cairo_t* cr, const double xc, const double yc, const double radius,
                           const double min, const double max, 
                           const BStyles::Color fgColor, const BStyles::Color bgColor);
+	void drawArcBackground (cairo_t* cr, const double xc, const double yc, const double radius, const BStyles::Color bgColor);
+	void drawArcFill (cairo_t* cr, const double xc, const double yc, const double radius,
+					  const double min, const double max, const BStyles::Color fgColor);
 	virtual void draw () override;
     virtual void draw (const double x0, const double y0, const double width, const double height) override;
     virtual void draw (const BUtilities::Area<>& area) override;
+
+	// Static arc background, only the value arc is drawn per frame
+	LayerCache background_;
 };
 
 inline BAngrDial::BAngrDial () :
@@ -119,17 +126,25 @@ inline void BAngrDial::update ()
 inline void BAngrDial::drawArc     (cairo_t* cr, const double xc, const double yc, const double radius,
                          const double min, const double max, 
                          const BStyles::Color fgColor, const BStyles::Color bgColor)
+{
+	drawArcBackground (cr, xc, yc, radius, bgColor);
+	drawArcFill (cr, xc, yc, radius, min, max, fgColor);
+}
+
+inline void BAngrDial::drawArcBackground (cairo_t* cr, const double xc, const double yc, const double radius, const BStyles::Color bgColor)
 {
     cairo_set_line_width (cr, 0.0);
-    
-    // Arc
     cairo_set_source_rgba (cr, CAIRO_RGBA(bgColor));
     cairo_arc (cr, xc, yc, 0.96 * radius, BWIDGETS_DEFAULT_DRAWARC_START, BWIDGETS_DEFAULT_DRAWARC_END);
     cairo_arc_negative (cr, xc, yc, 0.70 * radius, BWIDGETS_DEFAULT_DRAWARC_END, BWIDGETS_DEFAULT_DRAWARC_START);
     cairo_close_path (cr);
     cairo_fill (cr);
+}
 
-    // Fill
+inline void BAngrDial::drawArcFill (cairo_t* cr, const double xc, const double yc, const double radius,
+									const double min, const double max, const BStyles::Color fgColor)
+{
+    cairo_set_line_width (cr, 0.0);
 	cairo_set_source_rgba (cr, CAIRO_RGBA(fgColor));
     cairo_arc (cr, xc, yc,  0.96 * radius - 0.2, BWIDGETS_DEFAULT_DRAWARC_START + min * BWIDGETS_DEFAULT_DRAWARC_SIZE, BWIDGETS_DEFAULT_DRAWARC_START + max * BWIDGETS_DEFAULT_DRAWARC_SIZE);
     cairo_arc_negative (cr, xc, yc,  0.7 * radius - 0.2, BWIDGETS_DEFAULT_DRAWARC_START + max * BWIDGETS_DEFAULT_DRAWARC_SIZE, BWIDGETS_DEFAULT_DRAWARC_START + min * BWIDGETS_DEFAULT_DRAWARC_SIZE);
@@ -169,16 +184,27 @@ inline void BAngrDial::draw (const BUtilities::Area<>& area)
 			const double rad = 0.5 * (scale_.getWidth() < scale_.getHeight() ? scale_.getWidth() : scale_.getHeight());
 			const BStyles::Color fgColor = getFgColors()[getStatus()];
 			const BStyles::Color bgColor = getBgColors()[getStatus()];
+			const double xc = getXOffset() + 0.5 * getEffectiveWidth();
+			const double yc = getYOffset() + 0.5 * getEffectiveHeight();
 
-			if (step_ >= 0.0)
+			// Arc background from cache, (re-)draw on zoom, resize or style changes
+			const double scale = LayerCache::getScale (cairoSurface());
+			const uint64_t key = LayerCache::makeKey ({xc, yc, rad, bgColor.red, bgColor.green, bgColor.blue, bgColor.alpha});
+			if (!background_.isValid (getWidth(), getHeight(), scale, key))
 			{
-				drawArc (cr, getXOffset() + 0.5 * getEffectiveWidth(), getYOffset() + 0.5 * getEffectiveHeight(), rad - 1.0, 0.0, rval, fgColor, bgColor);
+				cairo_t* lcr = background_.create (getWidth(), getHeight(), scale, key);
+				if (lcr)
+				{
+					drawArcBackground (lcr, xc, yc, rad - 1.0, bgColor);
+					cairo_destroy (lcr);
+				}
 			}
 
-			else
-			{
-				drawArc (cr, getXOffset() + 0.5 * getEffectiveWidth(), getYOffset() + 0.5 * getEffectiveHeight(), rad - 1.0, 1.0 - rval, 1.0, fgColor, bgColor);
-			}
+			if (background_.isValid (getWidth(), getHeight(), scale, key)) background_.paint (cr);
+			else drawArcBackground (cr, xc, yc, rad - 1.0, bgColor);
+
+			if (step_ >= 0.0) drawArcFill (cr, xc, yc, rad - 1.0, 0.0, rval, fgColor);
+			else drawArcFill (cr, xc, yc, rad - 1.0, 1.0 - rval, 1.0, fgColor);
 		}
 
 		cairo_destroy (cr);
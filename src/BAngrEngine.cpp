@@ -0,0 +1,494 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#include "BAngrEngine.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include "ControllerLimits.hpp"
+#include "Blend.hpp"
+#include "DenormalGuard.hpp"
+#include "Trace.hpp"
+
+#define LIMIT(g , min, max) ((g) > (max) ? (max) : ((g) < (min) ? (min) : (g)))
+
+const float flexTime[NR_FLEX] = {1.0f, 0.05f, 0.05f, 0.05f, 0.05f};
+const float rampTime = 0.01f;
+const uint64_t fxControllerMask = ((uint64_t (1) << (NR_FX * NR_PARAMS)) - 1) << FX;
+
+BAngrEngine::BAngrEngine (const double rate, const uint32_t maxBlock) :
+	tracer (nullptr),
+	rate (rate),
+	maxBlock (maxBlock),
+	xcursor (0.5f),
+	ycursor (0.5f),
+	listen (false),
+	rnd (), 
+	count (0),
+	fader (0.0f),
+	speed (0.0f),
+	speedrand (0.0f),
+	dspeedrand (0.0f),
+	speedflex (0.0f),
+	spin (0.0f),
+	spinrand (0.0f),
+	dspinrand (0.0f),
+	spinflex (0.0f),
+	spindir (1.0f),
+	ang (2.0 * M_PI * rnd.rand_range(-1.0f, 1.0f)),
+	speedlevel (0.0f),
+	speedmaxlevel (0.1f),
+	spinlevel (0.0f),
+	spinmaxlevel (0.1f),
+	lowpassFilter (rate, 200.0, 8),
+	highpassFilter (rate, 4000.0, 8),
+	bandpassFilter (rate, 200.0, 4000.0, 8),
+	controllers {0.0f},
+	portControllers {0.0f},
+	controllerTargets {0.0f},
+	controllerSteps {0.0f},
+	dirtyControllers (0),
+	rampingControllers (0),
+	rampCount (0),
+	controllersValid (false),
+	params {0.0f},
+	blendXCursor (0.5f),
+	blendYCursor (0.5f),
+	paramsDirty (true),
+	xregion (rate)
+{
+	std::copy (controllerDefaults, controllerDefaults + NR_CONTROLLERS, portControllers);
+#ifdef BANGR_TRACE
+	tracer = new Tracer ();
+	tracer->open (rate);
+#endif
+}
+
+BAngrEngine::~BAngrEngine ()
+{
+#ifdef BANGR_TRACE
+	delete tracer;
+#endif
+}
+
+void BAngrEngine::prepare (const double rate, const uint32_t maxBlock)
+{
+	this->maxBlock = maxBlock;
+	if (rate == this->rate) return;
+
+	this->rate = rate;
+	lowpassFilter = ButterworthLowPassFilter (rate, 200.0, 8);
+	highpassFilter = ButterworthHighPassFilter (rate, 4000.0, 8);
+	bandpassFilter = ButterworthBandPassFilter (rate, 200.0, 4000.0, 8);
+	xregion.setRate (rate);
+#ifdef BANGR_TRACE
+	tracer->setRate (rate);
+#endif
+}
+
+void BAngrEngine::setController (const int index, const float value)
+{
+	if ((index < 0) || (index >= NR_CONTROLLERS) || (value == portControllers[index])) return;
+	portControllers[index] = value;
+	dirtyControllers |= uint64_t (1) << index;
+}
+
+float BAngrEngine::getController (const int index) const
+{
+	return ((index >= 0) && (index < NR_CONTROLLERS) ? controllers[index] : 0.0f);
+}
+
+void BAngrEngine::setCursor (const float x, const float y)
+{
+	setXCursor (x);
+	setYCursor (y);
+}
+
+void BAngrEngine::setXCursor (const float x) {xcursor = LIMIT (x, 0.0f, 1.0f);}
+
+void BAngrEngine::setYCursor (const float y) {ycursor = LIMIT (y, 0.0f, 1.0f);}
+
+void BAngrEngine::setListen (const bool listen) {this->listen = listen;}
+
+bool BAngrEngine::getListen () const {return listen;}
+
+BAngrModulation BAngrEngine::getModulation () const
+{
+	const float v = (listen ? 0.0f : speed * speed);
+	return BAngrModulation {xcursor, ycursor, speed, spin, speedlevel, spinlevel, float (sin (ang)) * v, float (cos (ang)) * v};
+}
+
+void BAngrEngine::seed (const uint64_t value)
+{
+	rnd.seed (value);
+	ang = 2.0 * M_PI * rnd.rand_range(-1.0f, 1.0f);
+	const uint32_t left = rnd.rand<double>() * UINT32_MAX;
+	const uint32_t right = rnd.rand<double>() * UINT32_MAX;
+	xregion.seed (left, right);
+}
+
+void BAngrEngine::updateControllers (const uint64_t dirty)
+{
+	const uint32_t rampLength = std::max (uint32_t (rampTime * rate), uint32_t (1));
+	bool newRamps = false;
+
+	for (uint64_t d = dirty & ((uint64_t (1) << NR_CONTROLLERS) - 1); d; d &= d - 1)
+	{
+		const int i = __builtin_ctzll (d);
+		const uint64_t bit = uint64_t (1) << i;
+		const float value = controllerLimits[i].validate (portControllers[i]);
+		controllerTargets[i] = value;
+
+		// Discrete controllers, initial values: Jump
+		if ((!controllersValid) || (controllerLimits[i].step != 0.0f) || (rampLength <= 1))
+		{
+			controllers[i] = value;
+			rampingControllers &= ~bit;
+		}
+
+		// Continuous controllers: Linear ramp
+		else if (value != controllers[i])
+		{
+			rampingControllers |= bit;
+			newRamps = true;
+		}
+
+		else rampingControllers &= ~bit;
+	}
+
+	// (Re-)start all running ramps from their current values
+	if (newRamps)
+	{
+		rampCount = rampLength;
+		for (uint64_t r = rampingControllers; r; r &= r - 1)
+		{
+			const int i = __builtin_ctzll (r);
+			controllerSteps[i] = (controllerTargets[i] - controllers[i]) / rampLength;
+		}
+	}
+
+	if (dirty & fxControllerMask) paramsDirty = true;
+	controllersValid = true;
+}
+
+void BAngrEngine::advanceRamps ()
+{
+	if (rampCount > 0) --rampCount;
+
+	for (uint64_t r = rampingControllers; r; r &= r - 1)
+	{
+		const int i = __builtin_ctzll (r);
+		controllers[i] = (rampCount ? controllers[i] + controllerSteps[i] : controllerTargets[i]);
+	}
+
+	if (rampingControllers & fxControllerMask) paramsDirty = true;
+	if (rampCount == 0) rampingControllers = 0;
+}
+
+void BAngrEngine::process (const float* input1, const float* input2, float* output1, float* output2, const uint32_t n)
+{
+	// Flush denormals to zero while processing, restores host setting
+	const DenormalGuard denormalGuard;
+
+	// Apply changed controllers, all on the first call
+	if (dirtyControllers || (!controllersValid))
+	{
+		updateControllers (controllersValid ? dirtyControllers : ~uint64_t (0));
+		dirtyControllers = 0;
+	}
+
+	for (uint32_t i = 0; i < n; ++i)
+	{
+		if (rampingControllers) advanceRamps ();
+		TRACE_LAP (tracer, TRACE_EVENTS);
+
+		// Update cursor
+		if (!listen)
+		{
+			if (count >= rate)
+			{
+				dspeedrand = rnd.rand_range(-1.0f, 1.0f) * controllers[SPEED_RANGE] - speedrand;
+				dspinrand = rnd.rand_range(-1.0f, 1.0f) * controllers[SPIN_RANGE] - spinrand;
+				count = 0.0;
+			}
+
+			else count++;
+
+			float dspeedflex;
+			float dspinflex;
+			const int speedtype = controllers[SPEED_TYPE];
+			const int spintype = controllers[SPIN_TYPE];
+
+			// Filter lows, mids, highs for level calculation
+			std::array<float, NR_FLEX> s;
+			s.fill (0.5f * (input1[i] + input2[i]));
+			if ((speedtype == LOWS) || (spintype == LOWS)) s[LOWS] = lowpassFilter.process (s[LOWS]);
+			if ((speedtype == MIDS) || (spintype == MIDS)) s[MIDS] = bandpassFilter.process (s[MIDS]);
+			if ((speedtype == HIGHS) || (spintype == HIGHS)) s[HIGHS] = highpassFilter.process (s[HIGHS]);
+			TRACE_LAP (tracer, TRACE_FILTERS);
+
+			// Calculate change in speed flexibility
+			if (speedtype == RANDOM) dspeedflex = dspeedrand * (1.0f / (flexTime[speedtype] * rate));
+			else 
+			{
+				// Calculate level
+				const float coeff = fabsf (s[speedtype]);
+				if (coeff >= speedmaxlevel) speedmaxlevel = coeff;
+				else speedmaxlevel = (1.0 - 1.0 / (4.0 * rate)) * speedmaxlevel;
+				if (speedmaxlevel < 0.0001f) speedmaxlevel = 0.0001f;	// Limit to -80 db to prevent div by zero
+				speedlevel = (1.0 - 1.0 / (flexTime[LEVEL] * rate)) * speedlevel + 1.0 / (flexTime[LEVEL] * rate) * (2.0 * coeff / speedmaxlevel);
+
+				dspeedflex = (2.0f * LIMIT (speedlevel, 0.0f, 1.0f) - 1.0f) * controllers[SPEED_RANGE] - speedflex;
+
+				// Command line meter (for debugging)
+				/*
+				if (int(count) % 1000 == 0) 
+				{
+					char s[41];
+					memset (s, ' ', 40);
+					int x = int (40 * LIMIT (speedlevel, 0.0f, 1.0f));
+					memset (s, '.', x);
+					s[40] = 0;
+					fprintf (stderr, "\r%s", s);
+				}
+				*/
+			}
+
+			// Calculate change in spin flexibility
+			if (spintype == RANDOM) dspinflex =  dspinrand * (1.0f / (flexTime[spintype] * rate));
+			else
+			{
+				// Calculate level
+				const float coeff = fabsf (s[spintype]);
+				if (coeff >= spinmaxlevel) spinmaxlevel = coeff;
+				else spinmaxlevel = (1.0 - 1.0 / (4.0 * rate)) * spinmaxlevel;
+				if (spinmaxlevel < 0.0001f) spinmaxlevel = 0.0001f;	// Limit to -80 db to prevent div by zero
+				const float nspinlevel = (1.0 - 1.0 / (flexTime[LEVEL] * rate)) * spinlevel + 1.0 / (flexTime[LEVEL] * rate) * (2.0 * coeff / spinmaxlevel);
+
+				if ((spinlevel >= 0.2f) && (nspinlevel < 0.2f)) spindir = (rnd.rand_range(-1.0f, 1.0f) >= 0.0f ? spindir : -spindir);
+				spinlevel = nspinlevel;
+				dspinflex = spindir * LIMIT (spinlevel, 0.0f, 1.0f) * controllers[SPIN_RANGE] - spinflex;
+			}; 
+			TRACE_LAP (tracer, TRACE_FOLLOWERS);
+
+			// Update speed
+			speedrand += (1.0f / rate) * dspeedrand;
+			speedflex += dspeedflex;
+			speed = controllers[SPEED] + controllers[SPEED_AMOUNT] * speedflex + (1.0f - controllers[SPEED_AMOUNT]) * speedrand;
+			speed = LIMIT (speed, 0.0f, 1.0f);
+
+			// Update ang
+			spinrand += (1.0f / rate) * dspinrand;
+			spinflex += dspinflex;
+			spin = controllers[SPIN] + controllers[SPIN_AMOUNT] * spinflex + (1.0f - controllers[SPIN_AMOUNT]) * spinrand;
+			spin = LIMIT (spin, -1.0f, 1.0f);
+			ang += 2.0 * M_PI * (10.0 / rate) * spin;
+			// Keep ang in [-pi, pi], otherwise float resolution gets lost
+			if (ang > M_PI) ang -= 2.0 * M_PI;
+			else if (ang < -M_PI) ang += 2.0 * M_PI;
+
+			// Calulate new positions
+			const float dx = sinf (ang);
+			const float dy = cosf (ang);
+			xcursor += dx * (1.0 / rate) * speed * speed;
+			ycursor += dy * (1.0 / rate) * speed * speed;
+
+			// Reflections
+			if (xcursor < 0.0f)
+			{
+				xcursor = 0.0f;
+				if (dx < 0.0f) {ang = -ang; spin = 0.0f;}
+			}
+
+			else if (xcursor > 1.0f)
+			{
+				xcursor = 1.0f;
+				if (dx > 0.0f) {ang = -ang; spin = 0.0f;}
+			}
+
+			if (ycursor < 0.0f)
+			{
+				ycursor = 0.0f;
+				if (dy < 0.0f) {ang = -M_PI - ang; spin = 0.0f;}
+			}
+
+			else if (ycursor > 1.0f)
+			{
+				ycursor = 1.0f;
+				if (dy > 0.0f) {ang = -M_PI - ang; spin = 0.0f;}
+			}
+			TRACE_LAP (tracer, TRACE_CURSOR);
+		}
+
+		// Calculate params for cursor position, skip if neither cursor nor FX controllers changed
+		if (paramsDirty || (xcursor != blendXCursor) || (ycursor != blendYCursor))
+		{
+			blendParams (xcursor, ycursor, &controllers[FX], params);
+			blendXCursor = xcursor;
+			blendYCursor = ycursor;
+			paramsDirty = false;
+			xregion.setParameters (params);
+		}
+		TRACE_LAP (tracer, TRACE_BLEND);
+
+		// Update fader
+		if (fader != (1.0f - controllers[BYPASS]))
+		{
+			fader += (fader < 1.0f - controllers[BYPASS] ? 100.0 / rate : -100.0 / rate);
+			fader = LIMIT (fader, 0.0f, 1.0f);
+		}
+
+		// Set params and process
+		if (fader)
+		{
+			float out1 = output1[i];
+			float out2 = output2[i];
+			xregion.prepare ();
+			TRACE_LAP (tracer, TRACE_COEFFICIENTS);
+			xregion.process (const_cast<float*> (&input1[i]), const_cast<float*> (&input2[i]), &out1, &out2, 1);
+			TRACE_LAP (tracer, TRACE_KERNEL);
+
+			// Dry/wet mix
+			output1[i] = fader * controllers[DRY_WET] * out1 + (1.0f - fader * controllers[DRY_WET]) * input1[i];
+			output2[i] = fader * controllers[DRY_WET] * out2 + (1.0f - fader * controllers[DRY_WET]) * input2[i];
+		}
+
+		else
+		{
+			output1[i] = input1[i];
+			output2[i] = input2[i];
+
+		}
+		TRACE_LAP (tracer, TRACE_MIX);
+	}
+}
+
+size_t BAngrEngine::getCheckpointSize () const
+{
+	CheckpointWriter writer;
+	writeCheckpoint (writer);
+	return writer.getPosition();
+}
+
+size_t BAngrEngine::saveCheckpoint (uint8_t* data, const size_t size) const
+{
+	CheckpointWriter writer (data, size);
+	writeCheckpoint (writer);
+	return (writer.isValid() ? writer.getPosition() : 0);
+}
+
+bool BAngrEngine::restoreCheckpoint (const uint8_t* data, const size_t size)
+{
+	// Validate header before touching any DSP state
+	if ((!data) || (size != getCheckpointSize())) return false;
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	double srate = 0.0;
+	CheckpointReader header (data, size);
+	header.get (magic);
+	header.get (version);
+	header.get (srate);
+	if ((magic != BANGR_CHECKPOINT_MAGIC) || (version != BANGR_CHECKPOINT_VERSION) || (srate != rate)) return false;
+
+	CheckpointReader reader (data, size);
+	readCheckpoint (reader);
+	return reader.isValid();
+}
+
+void BAngrEngine::writeCheckpoint (CheckpointWriter& writer) const
+{
+	writer.put (BANGR_CHECKPOINT_MAGIC);
+	writer.put (BANGR_CHECKPOINT_VERSION);
+	writer.put (rate);
+
+	writer.put (xcursor);
+	writer.put (ycursor);
+	rnd.writeCheckpoint (writer);
+	writer.put (count);
+	writer.put (fader);
+	writer.put (speed);
+	writer.put (speedrand);
+	writer.put (dspeedrand);
+	writer.put (speedflex);
+	writer.put (spin);
+	writer.put (spinrand);
+	writer.put (dspinrand);
+	writer.put (spinflex);
+	writer.put (spindir);
+	writer.put (ang);
+	writer.put (speedlevel);
+	writer.put (speedmaxlevel);
+	writer.put (spinlevel);
+	writer.put (spinmaxlevel);
+	lowpassFilter.writeCheckpoint (writer);
+	highpassFilter.writeCheckpoint (writer);
+	bandpassFilter.writeCheckpoint (writer);
+	writer.put (controllers, NR_CONTROLLERS);
+	writer.put (portControllers, NR_CONTROLLERS);
+	writer.put (controllerTargets, NR_CONTROLLERS);
+	writer.put (controllerSteps, NR_CONTROLLERS);
+	writer.put (rampingControllers);
+	writer.put (rampCount);
+	writer.put (controllersValid);
+	xregion.writeCheckpoint (writer);
+}
+
+void BAngrEngine::readCheckpoint (CheckpointReader& reader)
+{
+	uint32_t magic;
+	uint32_t version;
+	double srate;
+	reader.get (magic);
+	reader.get (version);
+	reader.get (srate);
+
+	reader.get (xcursor);
+	reader.get (ycursor);
+	rnd.readCheckpoint (reader);
+	reader.get (count);
+	reader.get (fader);
+	reader.get (speed);
+	reader.get (speedrand);
+	reader.get (dspeedrand);
+	reader.get (speedflex);
+	reader.get (spin);
+	reader.get (spinrand);
+	reader.get (dspinrand);
+	reader.get (spinflex);
+	reader.get (spindir);
+	reader.get (ang);
+	reader.get (speedlevel);
+	reader.get (speedmaxlevel);
+	reader.get (spinlevel);
+	reader.get (spinmaxlevel);
+	lowpassFilter.readCheckpoint (reader);
+	highpassFilter.readCheckpoint (reader);
+	bandpassFilter.readCheckpoint (reader);
+	reader.get (controllers, NR_CONTROLLERS);
+	reader.get (portControllers, NR_CONTROLLERS);
+	reader.get (controllerTargets, NR_CONTROLLERS);
+	reader.get (controllerSteps, NR_CONTROLLERS);
+	reader.get (rampingControllers);
+	reader.get (rampCount);
+	reader.get (controllersValid);
+	xregion.readCheckpoint (reader);
+	dirtyControllers = 0;
+	paramsDirty = true;
+}
@@ -0,0 +1,218 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BANGRENGINE_HPP_
+#define BANGRENGINE_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include "Ports.hpp"
+#include "Checkpoint.hpp"
+#include "RTRand.hpp"
+#include "Airwindows/XRegion.hpp"
+#include "ButterworthLowPassFilter.hpp"
+#include "ButterworthHighPassFilter.hpp"
+#include "ButterworthBandPassFilter.hpp"
+
+class Tracer;
+
+/**
+Modulation state of the engine (cursor physics and level followers).
+ */
+struct BAngrModulation
+{
+	float xcursor;
+	float ycursor;
+	float speed;
+	float spin;
+	float speedlevel;
+	float spinlevel;
+	float xvelocity;	// Cursor velocity in units per second, 0 if listening
+	float yvelocity;
+};
+
+/**
+Host-agnostic B.Angr DSP with a plain block API. Contains the complete
+DSP state (controllers and ramps, cursor physics, level followers and
+XRegion) but no plugin API specific parts. Doesn't allocate and doesn't
+block in process().
+ */
+class BAngrEngine
+{
+public:
+	BAngrEngine (const double rate, const uint32_t maxBlock = 0);
+	~BAngrEngine ();
+
+	BAngrEngine (const BAngrEngine& that) = delete;
+	BAngrEngine& operator= (const BAngrEngine& that) = delete;
+
+	/**
+	Sets the sample rate and the maximum block size. Rebuilds the rate
+	dependent filters. Must not be called concurrently to process().
+	@param rate	Sample rate in Hz.
+	@param maxBlock	Maximum number of frames per process() call or 0 if
+			unknown. The engine processes sample by sample and thus
+			doesn't need to preallocate block buffers.
+	 */
+	void prepare (const double rate, const uint32_t maxBlock);
+
+	/**
+	Sets a controller. The value is validated and applied with the next
+	process() call. Continuous controllers are ramped.
+	@param index	Controller index (see BAngrPortIndex, relative to
+			CONTROLLERS).
+	@param value	Controller value.
+	 */
+	void setController (const int index, const float value);
+
+	/**
+	Gets the current (validated and ramped) value of a controller.
+	@param index	Controller index.
+	@return		Controller value.
+	 */
+	float getController (const int index) const;
+
+	/**
+	Sets the cursor position. Values are limited to [0, 1].
+	 */
+	void setCursor (const float x, const float y);
+	void setXCursor (const float x);
+	void setYCursor (const float y);
+
+	/**
+	Enables or disables the automatic cursor movement. If listen is set,
+	the cursor is only moved by setCursor().
+	 */
+	void setListen (const bool listen);
+	bool getListen () const;
+
+	/**
+	Gets the modulation state after the last processed frame.
+	 */
+	BAngrModulation getModulation () const;
+
+	/**
+	Re-seeds all random sources of the DSP (random generator, initial
+	cursor angle and XRegion dither). Engines seeded with the same value
+	and fed with the same input and controllers produce identical output.
+	Must not be called concurrently to process().
+	@param value	Seed.
+	 */
+	void seed (const uint64_t value);
+
+	/**
+	Processes a block of stereo audio. Pending controller changes are
+	applied first. In-place processing is supported. Denormals are
+	flushed to zero (FTZ, DAZ) while processing, the floating point
+	control state of the caller is restored afterwards.
+	@param input1	Left input.
+	@param input2	Right input.
+	@param output1	Left output.
+	@param output2	Right output.
+	@param n	Number of frames.
+	 */
+	void process (const float* input1, const float* input2, float* output1, float* output2, const uint32_t n);
+
+	/**
+	Gets the size of a complete DSP snapshot.
+	@return	Size in bytes.
+	 */
+	size_t getCheckpointSize () const;
+
+	/**
+	Writes a versioned binary snapshot of the complete DSP state (cursor,
+	random generator, modulation integrators, level followers, filter
+	buffers, XRegion histories and validated controllers).
+	@param data	Target buffer.
+	@param size	Size of the target buffer.
+	@return		Number of bytes written, or 0 if the buffer is too small.
+	 */
+	size_t saveCheckpoint (uint8_t* data, const size_t size) const;
+
+	/**
+	Restores the complete DSP state from a snapshot of the same version
+	taken at the same sample rate. Restoring and processing yields sample-
+	identical output to the engine the snapshot was taken from.
+	@param data	Snapshot data.
+	@param size	Size of the snapshot data.
+	@return		True on success, otherwise false and the DSP state remains
+			unchanged.
+	 */
+	bool restoreCheckpoint (const uint8_t* data, const size_t size);
+
+	/**
+	Provides the block probes of a tracing build (see Trace.hpp).
+	@return		Tracer, or nullptr if built without BANGR_TRACE.
+	 */
+	Tracer* getTracer () const {return tracer;}
+
+private:
+	Tracer* tracer;
+	double rate;
+	uint32_t maxBlock;
+	float xcursor;
+	float ycursor;
+	bool listen;
+	RTRand rnd;
+	double count;
+	float fader;
+	float speed;
+	float speedrand;
+	float dspeedrand;
+	float speedflex;
+	float spin;
+	float spinrand;
+	float dspinrand;
+	float spinflex;
+	float spindir;
+	float ang;
+	float speedlevel;
+	float speedmaxlevel;
+	float spinlevel;
+	float spinmaxlevel;
+	ButterworthLowPassFilter lowpassFilter;
+	ButterworthHighPassFilter highpassFilter;
+	ButterworthBandPassFilter bandpassFilter;
+
+	// Controllers
+	float controllers[NR_CONTROLLERS];
+	float portControllers[NR_CONTROLLERS];
+	float controllerTargets[NR_CONTROLLERS];
+	float controllerSteps[NR_CONTROLLERS];
+	uint64_t dirtyControllers;
+	uint64_t rampingControllers;
+	uint32_t rampCount;
+	bool controllersValid;
+
+	// Cursor-blended XRegion parameters
+	float params[NR_PARAMS];
+	float blendXCursor;
+	float blendYCursor;
+	bool paramsDirty;
+
+	XRegion xregion;
+
+	void updateControllers (const uint64_t dirty);
+	void advanceRamps ();
+	void writeCheckpoint (CheckpointWriter& writer) const;
+	void readCheckpoint (CheckpointReader& reader);
+};
+
+#endif /* BANGRENGINE_HPP_ */
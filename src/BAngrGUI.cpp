@@ -21,6 +21,9 @@
 #include "BAngrGUI.hpp"
 #include <cmath>
 #include <exception>
+#include <lv2/instance-access/instance-access.h>
+#include <lv2/data-access/data-access.h>
+#include <lv2/options/options.h>
 #include "BAngrDial.hpp"
 #include "BWidgets/BEvents/Event.hpp"
 #include "BWidgets/BEvents/ExposeEvent.hpp"
@@ -38,155 +41,112 @@ BAngrGUI::BAngrGUI (const char *bundle_path, const LV2_Feature *const *features,
 	controller (NULL), 
 	write_function (NULL),
 	pluginPath (bundle_path ? std::string (bundle_path) : std::string ("")),
-	map (nullptr),
-
-	mContainer(0, 0, 1000, 560, pluginPath + "inc/surface.png", URID ("/bgimage")),
-	cursor (480, 260, 40, 40, URID ("/dot")),
-	poweredLabel (720, 540, 250, 20, BDICT("Powered by Airwindows XRegion"), URID ("/rlabel")),
-	helpButton (918, 508, 24, 24, false, false, URID ("/halobutton"), BDICT ("Help")),
-	ytButton (948, 508, 24, 24, false, false, URID ("/halobutton"), BDICT ("Preview")),
-	bypassButton (900, 30, 20, 20, 2, true, false, URID ("/redbutton"), BDICT ("Bypass")),
-	bypassLabel (880, 60, 60, 20, BDICT ("Bypass"), URID ("/label")),
-	drywetDial (940, 20, 40, 40, 1.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Dry/wet")),
-	drywetLabel (930, 60, 60, 20, BDICT ("Dry/wet"), URID ("/label")),
-	speedDial (370, 460, 60, 60, 0.5, 0.5, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Speed")),
-	speedLabel (350, 520, 100, 20, BDICT("Speed"), URID("/label")),
-	spinDial (570, 460, 60, 60, 0.0, 0.0, -1.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Spin")),
-	spinLabel (550, 520, 100, 20, BDICT("Spin"), URID("/label")),
-	speedScreen (180, 480, 100, 35, URID("/screen")),
-	speedFlexLabel (220, 520, 100, 20, BDICT("Flexibility"), URID("/label")),
-	speedTypeCombobox (280, 490, 80, 20, 0, -120, 80, 120, {BDICT("Random"), BDICT("Level"), BDICT("Lows"), BDICT("Mids"), BDICT("Highs")}, 1, URID("/menu")),
-	speedAmountSlider (200, 485, 80, 20, 0.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Speed")),
-	spinScreen (640, 480, 100, 35, URID("/screen")),
-	spinFlexLabel (680, 520, 100, 20, BDICT("Flexibility"), URID("/label")),
-	spinTypeCombobox (740, 490, 80, 20, 0, -120, 80, 120, {BDICT("Random"), BDICT("Level"), BDICT("Lows"), BDICT("Mids"), BDICT("Highs")}, 1, URID("/menu")),
-	spinAmountSlider (660, 485, 80, 20, 0.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Spin"))
+	map (getURIDMap (features)),
+	urids (mapURIs (map)),
+	cursorPending (false),
+	cursorDragged (false),
+	telemetry (nullptr),
+	zoom (1.0),
+	frameRate (BANGR_GUI_DEFAULT_FRAME_RATE),
+	nextFrame (std::chrono::steady_clock::now()),
+	pendingControllers {0.0f},
+	pendingControllerMask (0),
+	pendingXCursor (0.5f),
+	pendingYCursor (0.5f),
+	pendingXCursorSet (false),
+	pendingYCursorSet (false),
+	pendingXVelocity (0.0f),
+	pendingYVelocity (0.0f),
+	pendingVelocitySet (false),
+	pendingLoad (0.0f),
+	pendingPeak (0.0f),
+	pendingLoadSet (false),
+	pendingPeakSet (false),
+	pendingTrail (false),
+	nextTrailPoint (std::chrono::steady_clock::now()),
+	cursorTrack {0.5, 0.5, 0.0, 0.0, 0.0, 0.0, std::chrono::steady_clock::now()},
+
+	widgets (BAngrResources::acquire (pluginPath + "inc/surface.png"))
 {
-	// Init param widgets
-	for (int i = 0; i < NR_FX; ++i)
-	{
-		fx[i].container = new BWidgets::Widget (20 + int (i / 2) * 660, 100 + int (((i + 1) & 3) / 2) * 200, 300, 160, URID ("/widget"));
-		fx[i].paramDials[0] = new BAngrDial (0, 10, 60, 60, 0.5, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Gain"));
-		fx[i].paramLabels[0] = new BWidgets::Label (0, 70, 60, 20, BDICT("Gain"), URID("/label"));
-		fx[i].paramDials[1] = new BAngrDial (80, 10, 60, 60, 0.5, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("First"));
-		fx[i].paramLabels[1] = new BWidgets::Label (80, 70, 60, 20, BDICT("First"), URID("/label"));
-		fx[i].paramDials[2] = new BAngrDial (160, 10, 60, 60, 0.5, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Last"));
-		fx[i].paramLabels[2] = new BWidgets::Label (160, 70, 60, 20, BDICT("Last"), URID("/label"));
-		fx[i].paramDials[3] = new BAngrDial (240, 10, 60, 60, 0.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Nuke"));
-		fx[i].paramLabels[3] = new BWidgets::Label (240, 70, 60, 20, BDICT("Nuke"), URID("/label"));
-		fx[i].paramDials[4] = new BAngrDial (40, 70, 60, 60, 1.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Mix"));
-		fx[i].paramLabels[4] = new BWidgets::Label (40, 130, 60, 20, BDICT("Mix"), URID("/label"));
-		fx[i].paramDials[5] = new BAngrDial (200, 70, 60, 60, 0.0, -1.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Pan"));
-		fx[i].paramLabels[5] = new BWidgets::Label (200, 130, 60, 20, BDICT("Pan"), URID("/label"));
-	}
+	lv2_atom_forge_init (&forge, map);
+
+	// Set callbacks
+	for (BWidgets::Widget* c : widgets.controllerWidgets) c->setCallbackFunction (BEvents::Event::EventType::valueChangedEvent, BAngrGUI::valueChangedCallback);
+	widgets.cursor.setCallbackFunction (BEvents::Event::EventType::pointerDragEvent, BAngrGUI::cursorDraggedCallback);
+	widgets.cursor.setCallbackFunction (BEvents::Event::EventType::buttonPressEvent, BAngrGUI::cursorDraggedCallback);
+	widgets.cursor.setCallbackFunction (BEvents::Event::EventType::buttonReleaseEvent, BAngrGUI::cursorReleasedCallback);
+	widgets.cursorGrip.setCallbackFunction (BEvents::Event::EventType::pointerDragEvent, BAngrGUI::cursorDraggedCallback);
+	widgets.cursorGrip.setCallbackFunction (BEvents::Event::EventType::buttonPressEvent, BAngrGUI::cursorDraggedCallback);
+	widgets.cursorGrip.setCallbackFunction (BEvents::Event::EventType::buttonReleaseEvent, BAngrGUI::cursorReleasedCallback);
+	widgets.poweredLabel.setCallbackFunction (BEvents::Event::EventType::buttonPressEvent, BAngrGUI::xregionClickedCallback);
+	widgets.helpButton.setCallbackFunction (BEvents::Event::EventType::buttonPressEvent, BAngrGUI::helpButtonClickedCallback);
+	widgets.ytButton.setCallbackFunction (BEvents::Event::EventType::buttonPressEvent, BAngrGUI::ytButtonClickedCallback);
+
+	add (&widgets.mContainer);
+
+	// Apply the shared (already resolved) theme once to the complete tree
+	setTheme(widgets.resources->getStyles().theme);
+
+	//Scan host features for plugin instance access and options
+	LV2_Handle instance = NULL;
+	const LV2_Extension_Data_Feature* dataAccess = NULL;
+	const LV2_Options_Option* options = NULL;
 
-	// Link controllers
-	controllerWidgets[BYPASS] = &bypassButton;
-	controllerWidgets[DRY_WET] = &drywetDial;
-	controllerWidgets[SPEED] = &speedDial;
-	controllerWidgets[SPEED_RANGE] = &speedDial.range;
-	controllerWidgets[SPEED_TYPE] = &speedTypeCombobox;
-	controllerWidgets[SPEED_AMOUNT] = &speedAmountSlider;
-	controllerWidgets[SPIN] = &spinDial;
-	controllerWidgets[SPIN_RANGE] = &spinDial.range;
-	controllerWidgets[SPIN_TYPE] = &spinTypeCombobox;
-	controllerWidgets[SPIN_AMOUNT] = &spinAmountSlider;
-
-	for (int i = 0; i < NR_FX; ++i)
+	for (int i = 0; features[i]; ++i)
 	{
-		for (int j = 0; j < NR_PARAMS; ++j)
-		{
-			controllerWidgets[FX + i * NR_PARAMS + j] = fx[i].paramDials[j];
-		}
+		if (strcmp(features[i]->URI, LV2_INSTANCE_ACCESS_URI) == 0) instance = static_cast<LV2_Handle> (features[i]->data);
+		else if (strcmp(features[i]->URI, LV2_DATA_ACCESS_URI) == 0) dataAccess = static_cast<const LV2_Extension_Data_Feature*> (features[i]->data);
+		else if (strcmp(features[i]->URI, LV2_OPTIONS__options) == 0) options = static_cast<const LV2_Options_Option*> (features[i]->data);
 	}
 
-	// Configure widgets
-	cursor.setDraggable (true);
-	drywetDial.setClickable(false);
-	drywetDial.setScrollable(true);
-	drywetDial.label.hide();
-	speedDial.setClickable(false);
-	speedDial.setScrollable(true);
-	spinDial.setClickable(false);
-	spinDial.setScrollable(true);
-	speedAmountSlider.setClickable(false);
-	speedAmountSlider.setScrollable(true);
-	spinAmountSlider.setClickable(false);
-	spinAmountSlider.setScrollable(true);
-	for (Fx& f : fx)
+	// Pace frames to the display update rate if provided by the host
+	if (options)
 	{
-		for (BAngrDial* b : f.paramDials)
+		const LV2_URID updateRate = map->map (map->handle, LV2_UI__updateRate);
+		for (const LV2_Options_Option* o = options; o->key; ++o)
 		{
-			b->setClickable(false);
-			b->setScrollable(true);
+			if ((o->key == updateRate) && (o->type == urids.atom_Float) && o->value)
+			{
+				const float rate = *static_cast<const float*> (o->value);
+				if (rate >= 1.0f) frameRate = std::min (rate, 240.0f);
+			}
 		}
 	}
-	setTheme(theme);
 
-
-	// Set callbacks
-	for (BWidgets::Widget* c : controllerWidgets) c->setCallbackFunction (BEvents::Event::EventType::valueChangedEvent, BAngrGUI::valueChangedCallback);
-	cursor.setCallbackFunction (BEvents::Event::EventType::pointerDragEvent, BAngrGUI::cursorDraggedCallback);
-	cursor.setCallbackFunction (BEvents::Event::EventType::buttonPressEvent, BAngrGUI::cursorDraggedCallback);
-	cursor.setCallbackFunction (BEvents::Event::EventType::buttonReleaseEvent, BAngrGUI::cursorReleasedCallback);
-	poweredLabel.setCallbackFunction (BEvents::Event::EventType::buttonPressEvent, BAngrGUI::xregionClickedCallback);
-	helpButton.setCallbackFunction (BEvents::Event::EventType::buttonPressEvent, BAngrGUI::helpButtonClickedCallback);
-	ytButton.setCallbackFunction (BEvents::Event::EventType::buttonPressEvent, BAngrGUI::ytButtonClickedCallback);
-
-	// Pack widgets
-	for (Fx& f : fx)
+	// Attach to telemetry ring if possible. Otherwise fallback to atom messages
+	if (instance && dataAccess && dataAccess->data_access)
 	{
-		for (BAngrDial* d : f.paramDials) f.container->add (d);
-		for (BWidgets::Label* l : f.paramLabels) f.container->add (l);
-		mContainer.add (f.container);
-	}
-	mContainer.add (&bypassButton);
-	mContainer.add (&bypassLabel);
-	mContainer.add (&drywetDial);
-	mContainer.add (&drywetLabel);
-	mContainer.add (&speedDial);
-	mContainer.add (&speedLabel);
-	mContainer.add (&spinDial);
-	mContainer.add (&spinLabel);
-	mContainer.add (&speedFlexLabel);
-	mContainer.add (&speedTypeCombobox);
-	mContainer.add (&speedAmountSlider);
-	mContainer.add (&spinFlexLabel);
-	mContainer.add (&spinTypeCombobox);
-	mContainer.add (&spinAmountSlider);
-	mContainer.add (&speedScreen);
-	mContainer.add (&spinScreen);
-	mContainer.add (&cursor);
-	mContainer.add (&poweredLabel);
-	mContainer.add (&helpButton);
-	mContainer.add (&ytButton);
-	add (&mContainer);
-
-	//Scan host features for URID map
-	LV2_URID_Map* m = NULL;
+		const BAngrTelemetryInterface* ti = static_cast<const BAngrTelemetryInterface*> (dataAccess->data_access (BANGR_TELEMETRY_URI));
+		BAngrTelemetry* t = (ti && ti->getTelemetry ? ti->getTelemetry (instance) : nullptr);
 
-	for (int i = 0; features[i]; ++i)
-	{
-		if (strcmp(features[i]->URI, LV2_URID__map) == 0) m = static_cast<LV2_URID_Map*> (features[i]->data);
+		// Single consumer: Only claim if no other GUI is attached
+		bool expected = false;
+		if (t && t->attached.compare_exchange_strong (expected, true)) telemetry = t;
 	}
-	if (!m) throw std::invalid_argument ("Host does not support urid:map");
-
-	//Map URIS
-	map = m;
-	getURIs (map, &urids);
-
-	// Initialize forge
-	lv2_atom_forge_init (&forge,map);
 }
 
 BAngrGUI::~BAngrGUI()
 {
-	for (const Fx& fxi : fx)
+	// Release telemetry if claimed by this GUI
+	if (telemetry) telemetry->attached.store (false, std::memory_order_release);
+	sendUiOff ();
+}
+
+LV2_URID_Map* BAngrGUI::getURIDMap (const LV2_Feature* const* features)
+{
+	// Fail before any widget is built
+	for (int i = 0; features[i]; ++i)
 	{
-		delete fxi.container;
-		for (const BAngrDial* d : fxi.paramDials) delete d;
-		for (const BWidgets::Label* l : fxi.paramLabels) delete l;
+		if ((strcmp(features[i]->URI, LV2_URID__map) == 0) && features[i]->data) return static_cast<LV2_URID_Map*> (features[i]->data);
 	}
+	throw std::invalid_argument ("Host does not support urid:map");
+}
+
+BAngrURIs BAngrGUI::mapURIs (LV2_URID_Map* m)
+{
+	BAngrURIs u;
+	getURIs (m, &u);
+	return u;
 }
 
 void BAngrGUI::portEvent(uint32_t port_index, uint32_t buffer_size, uint32_t format, const void* buffer)
@@ -199,7 +159,63 @@ void BAngrGUI::portEvent(uint32_t port_index, uint32_t buffer_size, uint32_t for
 		{
 			const LV2_Atom_Object* obj = reinterpret_cast<const LV2_Atom_Object*> (atom);
 			
-			if (obj->body.otype == urids.patch_Set)
+			// Cursor notification: Contains only the changed coordinates
+			if (obj->body.otype == urids.bangr_cursor)
+			{
+				const LV2_Atom* xAtom = NULL;
+				const LV2_Atom* yAtom = NULL;
+				const LV2_Atom* vxAtom = NULL;
+				const LV2_Atom* vyAtom = NULL;
+				lv2_atom_object_get
+				(
+					obj,
+					urids.bangr_xcursor, &xAtom,
+					urids.bangr_ycursor, &yAtom,
+					urids.bangr_xvelocity, &vxAtom,
+					urids.bangr_yvelocity, &vyAtom,
+					NULL
+				);
+
+				if (xAtom && (xAtom->type == urids.atom_Float))
+				{
+					pendingXCursor = reinterpret_cast<const LV2_Atom_Float*>(xAtom)->body;
+					pendingXCursorSet = true;
+				}
+				if (yAtom && (yAtom->type == urids.atom_Float))
+				{
+					pendingYCursor = reinterpret_cast<const LV2_Atom_Float*>(yAtom)->body;
+					pendingYCursorSet = true;
+				}
+				if (vxAtom && (vxAtom->type == urids.atom_Float) && vyAtom && (vyAtom->type == urids.atom_Float))
+				{
+					pendingXVelocity = reinterpret_cast<const LV2_Atom_Float*>(vxAtom)->body;
+					pendingYVelocity = reinterpret_cast<const LV2_Atom_Float*>(vyAtom)->body;
+					pendingVelocitySet = true;
+				}
+			}
+
+			// Trail notification: Batch of packed cursor positions. Points are
+			// collected here, the trail is redrawn once per frame. Sent for
+			// other GUIs only if this GUI is attached to the telemetry.
+			else if (obj->body.otype == urids.bangr_trail)
+			{
+				if (telemetry) return;
+				const LV2_Atom* pointsAtom = NULL;
+				lv2_atom_object_get (obj, urids.bangr_trailPoints, &pointsAtom, NULL);
+
+				if (pointsAtom && (pointsAtom->type == urids.atom_Vector))
+				{
+					const LV2_Atom_Vector* vec = reinterpret_cast<const LV2_Atom_Vector*> (pointsAtom);
+					if ((vec->body.child_type == urids.atom_Int) && (vec->body.child_size == sizeof (int32_t)) && (pointsAtom->size >= sizeof (LV2_Atom_Vector_Body)))
+					{
+						const uint32_t n = (pointsAtom->size - sizeof (LV2_Atom_Vector_Body)) / sizeof (int32_t);
+						widgets.trail.addPoints (static_cast<const uint32_t*> (LV2_ATOM_CONTENTS_CONST (LV2_Atom_Vector, vec)), n);
+						pendingTrail = true;
+					}
+				}
+			}
+
+			else if (obj->body.otype == urids.patch_Set)
 			{
 				const LV2_Atom* property = NULL;
       			const LV2_Atom* value    = NULL;
@@ -217,39 +233,81 @@ void BAngrGUI::portEvent(uint32_t port_index, uint32_t buffer_size, uint32_t for
 					
 					if ((key == urids.bangr_xcursor) && (value->type == urids.atom_Float)) 
 					{
-						const float xcursor = reinterpret_cast<const LV2_Atom_Float*>(value)->body;
-						cursor.moveTo ((400.0 + xcursor * 200.0) - 0.5 * cursor.getWidth(), cursor.getPosition().y);
+						pendingXCursor = reinterpret_cast<const LV2_Atom_Float*>(value)->body;
+						pendingXCursorSet = true;
 					}
 
 					else if ((key == urids.bangr_ycursor) && (value->type == urids.atom_Float)) 
 					{
-						const float ycursor = reinterpret_cast<const LV2_Atom_Float*>(value)->body;
-						cursor.moveTo (cursor.getPosition().x, (180.0 + ycursor * 200.0) - 0.5 * cursor.getHeight());
+						pendingYCursor = reinterpret_cast<const LV2_Atom_Float*>(value)->body;
+						pendingYCursorSet = true;
 					}
 				}
 			}
 		}
 	}
 
-	// Scan controller ports
+	// Controller ports: Only keep the latest value
 	else if ((format == 0) && (port_index >= CONTROLLERS) && (port_index < CONTROLLERS + NR_CONTROLLERS))
 	{
-		const float* pval = static_cast<const float*> (buffer);
+		pendingControllers[port_index - CONTROLLERS] = *static_cast<const float*> (buffer);
+		pendingControllerMask |= uint64_t (1) << (port_index - CONTROLLERS);
+	}
 
-		// Offst Comboboxes by 1
-		if ((port_index - CONTROLLERS == SPEED_TYPE) || (port_index - CONTROLLERS == SPIN_TYPE))
-		{
-			BWidgets::ComboBox* combobox = dynamic_cast<BWidgets::ComboBox*>(controllerWidgets[port_index - CONTROLLERS]);
-			if (combobox) combobox->setValue(*pval + 1);
-		}
+	// DSP load output ports
+	else if ((format == 0) && (port_index == DSP_LOAD))
+	{
+		pendingLoad = *static_cast<const float*> (buffer);
+		pendingLoadSet = true;
+	}
 
-		// All other control ports
-		else
-		{
-			BWidgets::ValueableTyped<double>* valueable = dynamic_cast<BWidgets::ValueableTyped<double>*>(controllerWidgets[port_index - CONTROLLERS]);
-			if (valueable) valueable->setValue (*pval);
-		}
+	else if ((format == 0) && (port_index == DSP_PEAK))
+	{
+		pendingPeak = *static_cast<const float*> (buffer);
+		pendingPeakSet = true;
+	}
+}
+
+void BAngrGUI::applyPortEvents ()
+{
+	// Controllers
+	for (int i = 0; pendingControllerMask; ++i, pendingControllerMask >>= 1)
+	{
+		if (!(pendingControllerMask & 1)) continue;
+
+		// Offset comboboxes by 1
+		if (i == SPEED_TYPE) widgets.speedTypeCombobox.setValue (pendingControllers[i] + 1);
+		else if (i == SPIN_TYPE) widgets.spinTypeCombobox.setValue (pendingControllers[i] + 1);
+		else if (widgets.controllerValueables[i]) widgets.controllerValueables[i]->setValue (pendingControllers[i]);
+	}
+
+	// Cursor: New track for both coordinates, missing coordinates are
+	// taken from the current track. Without velocity, the cursor stays.
+	if (pendingXCursorSet || pendingYCursorSet || pendingVelocitySet)
+	{
+		double x, y;
+		getCursorEstimate (std::chrono::steady_clock::now(), x, y);
+		setCursorTrack
+		(
+			(pendingXCursorSet ? pendingXCursor : x),
+			(pendingYCursorSet ? pendingYCursor : y),
+			(pendingVelocitySet ? pendingXVelocity : 0.0),
+			(pendingVelocitySet ? pendingYVelocity : 0.0)
+		);
+		pendingXCursorSet = false;
+		pendingYCursorSet = false;
+		pendingVelocitySet = false;
 	}
+
+	// DSP load
+	if (pendingLoadSet) widgets.loadMeter.setLoad (pendingLoad);
+	if (pendingPeakSet) widgets.loadMeter.setPeak (pendingPeak);
+	pendingLoadSet = false;
+	pendingPeakSet = false;
+
+	// Trail
+	if (pendingTrail) widgets.trail.update ();
+	pendingTrail = false;
 }
 
 void BAngrGUI::onConfigureRequest (BEvents::Event* event)
@@ -259,64 +317,138 @@ void BAngrGUI::onConfigureRequest (BEvents::Event* event)
 	BEvents::ExposeEvent* ee = dynamic_cast<BEvents::ExposeEvent*>(event);
 	if (!ee) return;
 	const double sz = (ee->getArea().getWidth() / 1000.0 > ee->getArea().getHeight() / 560.0 ? ee->getArea().getHeight() / 560.0 : ee->getArea().getWidth() / 1000.0);
+	zoom = sz;
 	setZoom (sz);
 }
 
-void BAngrGUI::sendCursor ()
+void BAngrGUI::handleIdle ()
 {
-	sendCursorOn();
-	sendXCursor();
-	sendYCursor();
+	// Hosts may call idle at much higher rates than the display can show.
+	// Collect changes until the next frame is due.
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (now < nextFrame) return;
+	const std::chrono::steady_clock::duration period = std::chrono::duration_cast<std::chrono::steady_clock::duration> (std::chrono::duration<double> (1.0 / frameRate));
+	nextFrame += period;
+	if (nextFrame < now) nextFrame = now + period;
+
+	applyPortEvents ();
+	applyTelemetry ();
+	animateCursor ();
+	handleEvents ();
+
+	// Send coalesced cursor drag (max. once per frame)
+	if (cursorPending) sendCursor (true);
 }
 
-void BAngrGUI::sendXCursor ()
+void BAngrGUI::applyTelemetry ()
 {
-	uint8_t obj_buf[128];
-	lv2_atom_forge_set_buffer(&forge, obj_buf, sizeof(obj_buf));
+	if (!telemetry) return;
 
-	LV2_Atom_Forge_Frame frame;
-	LV2_Atom* msg = reinterpret_cast<LV2_Atom*>(lv2_atom_forge_object(&forge, &frame, 0, urids.patch_Set));
-	lv2_atom_forge_key(&forge, urids.patch_property);
-	lv2_atom_forge_urid(&forge, urids.bangr_xcursor);
-	lv2_atom_forge_key(&forge, urids.patch_value);
-	lv2_atom_forge_float(&forge, ((cursor.getPosition().x + 0.5 * cursor.getWidth()) - 400.0) / 200.0);
-	lv2_atom_forge_pop(&forge, &frame);
-	write_function(controller, CONTROL, lv2_atom_total_size(msg), urids.atom_eventTransfer, msg);
+	// Drain ring, only the latest sample is shown
+	TelemetrySample sample;
+	bool received = false;
+	while (telemetry->ring.pop (sample)) received = true;
+
+	if (received && (!cursorDragged)) moveCursor (sample.xcursor, sample.ycursor);
+
+	// DSP load of the latest block
+	if (received)
+	{
+		widgets.loadMeter.setLoad (sample.load);
+		widgets.loadMeter.setPeak (sample.peak);
+	}
+
+	// Trail points with the DSP trail rate
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if (received && (!cursorDragged) && (now >= nextTrailPoint))
+	{
+		const uint32_t point = packTrailPoint (sample.xcursor, sample.ycursor);
+		widgets.trail.addPoints (&point, 1);
+		widgets.trail.update ();
+		nextTrailPoint += std::chrono::duration_cast<std::chrono::steady_clock::duration> (std::chrono::duration<double> (1.0 / BANGR_TRAIL_RATE));
+		if (nextTrailPoint < now) nextTrailPoint = now;
+	}
+}
+
+void BAngrGUI::setCursorTrack (const double xcursor, const double ycursor, const double vx, const double vy)
+{
+	const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	double x, y;
+	getCursorEstimate (now, x, y);
+	cursorTrack = CursorTrack {xcursor, ycursor, vx, vy, x - xcursor, y - ycursor, now};
+}
+
+void BAngrGUI::getCursorEstimate (const std::chrono::steady_clock::time_point& time, double& xcursor, double& ycursor) const
+{
+	// Extrapolate with the last known velocity (limited in time) and
+	// reflect at the borders like the DSP does
+	const double dt = std::chrono::duration<double> (time - cursorTrack.time).count();
+	const double t = LIMIT (dt, BANGR_GUI_CURSOR_MAX_EXTRAPOLATION);
+	const double fade = (dt < BANGR_GUI_CURSOR_CORRECTION_TIME ? 1.0 - dt / BANGR_GUI_CURSOR_CORRECTION_TIME : 0.0);
+	xcursor = fabs (cursorTrack.x + cursorTrack.vx * t);
+	ycursor = fabs (cursorTrack.y + cursorTrack.vy * t);
+	if (xcursor > 1.0) xcursor = std::max (2.0 - xcursor, 0.0);
+	if (ycursor > 1.0) ycursor = std::max (2.0 - ycursor, 0.0);
+	xcursor += fade * cursorTrack.ox;
+	ycursor += fade * cursorTrack.oy;
 }
 
-void BAngrGUI::sendYCursor ()
+void BAngrGUI::animateCursor ()
+{
+	// Telemetry and dragging directly set the cursor
+	if (telemetry || cursorDragged) return;
+
+	double x, y;
+	getCursorEstimate (std::chrono::steady_clock::now(), x, y);
+	moveCursor (x, y);
+}
+
+void BAngrGUI::moveCursor (const double xcursor, const double ycursor)
+{
+	// Snapped to the device pixel grid. Moves within a pixel don't change the
+	// display and thus don't cause any redraw. Otherwise only the old and the
+	// new cursor rectangle are damaged.
+	widgets.moveCursor (xcursor, ycursor, zoom);
+}
+
+void BAngrGUI::sendCursor (const bool listen)
 {
 	uint8_t obj_buf[128];
 	lv2_atom_forge_set_buffer(&forge, obj_buf, sizeof(obj_buf));
 
 	LV2_Atom_Forge_Frame frame;
-	LV2_Atom* msg = reinterpret_cast<LV2_Atom*>(lv2_atom_forge_object(&forge, &frame, 0, urids.patch_Set));
-	lv2_atom_forge_key(&forge, urids.patch_property);
-	lv2_atom_forge_urid(&forge, urids.bangr_ycursor);
-	lv2_atom_forge_key(&forge, urids.patch_value);
-	lv2_atom_forge_float(&forge, ((cursor.getPosition().y + 0.5 * cursor.getHeight()) - 180.0) / 200.0);
+	LV2_Atom* msg = reinterpret_cast<LV2_Atom*>(lv2_atom_forge_object(&forge, &frame, 0, urids.bangr_cursor));
+	lv2_atom_forge_key(&forge, urids.bangr_xcursor);
+	lv2_atom_forge_float(&forge, ((widgets.cursor.getPosition().x + 0.5 * widgets.cursor.getWidth()) - 400.0) / 200.0);
+	lv2_atom_forge_key(&forge, urids.bangr_ycursor);
+	lv2_atom_forge_float(&forge, ((widgets.cursor.getPosition().y + 0.5 * widgets.cursor.getHeight()) - 180.0) / 200.0);
+	lv2_atom_forge_key(&forge, urids.bangr_listen);
+	lv2_atom_forge_bool(&forge, listen);
 	lv2_atom_forge_pop(&forge, &frame);
 	write_function(controller, CONTROL, lv2_atom_total_size(msg), urids.atom_eventTransfer, msg);
+	cursorPending = false;
 }
 
-void BAngrGUI::sendCursorOn ()
+void BAngrGUI::sendUiOn ()
 {
 	uint8_t obj_buf[64];
 	lv2_atom_forge_set_buffer(&forge, obj_buf, sizeof(obj_buf));
 
 	LV2_Atom_Forge_Frame frame;
-	LV2_Atom* msg = reinterpret_cast<LV2_Atom*>(lv2_atom_forge_object(&forge, &frame, 0, urids.bangr_cursorOn));
+	LV2_Atom* msg = reinterpret_cast<LV2_Atom*>(lv2_atom_forge_object(&forge, &frame, 0, urids.bangr_uiOn));
 	lv2_atom_forge_pop(&forge, &frame);
 	write_function(controller, CONTROL, lv2_atom_total_size(msg), urids.atom_eventTransfer, msg);
 }
 
-void BAngrGUI::sendCursorOff ()
+void BAngrGUI::sendUiOff ()
 {
+	if (!write_function) return;
+
 	uint8_t obj_buf[64];
 	lv2_atom_forge_set_buffer(&forge, obj_buf, sizeof(obj_buf));
 
 	LV2_Atom_Forge_Frame frame;
-	LV2_Atom* msg = reinterpret_cast<LV2_Atom*>(lv2_atom_forge_object(&forge, &frame, 0, urids.bangr_cursorOff));
+	LV2_Atom* msg = reinterpret_cast<LV2_Atom*>(lv2_atom_forge_object(&forge, &frame, 0, urids.bangr_uiOff));
 	lv2_atom_forge_pop(&forge, &frame);
 	write_function(controller, CONTROL, lv2_atom_total_size(msg), urids.atom_eventTransfer, msg);
 }
@@ -337,7 +469,7 @@ void BAngrGUI::valueChangedCallback (BEvents::Event* event)
 	// Identify controller
 	for (int i = 0; i < NR_CONTROLLERS; ++i)
 	{
-		if (widget == ui->controllerWidgets[i])
+		if (widget == ui->widgets.controllerWidgets[i])
 		{
 			controllerNr = i;
 			break;
@@ -349,23 +481,23 @@ void BAngrGUI::valueChangedCallback (BEvents::Event* event)
 	{
 		if (controllerNr == SPEED_TYPE)
 		{
-			value = ui->speedTypeCombobox.getValue() - 1.0f;
-			if (value == RANDOM) ui->speedScreen.show();
-			else ui->speedScreen.hide();
+			value = ui->widgets.speedTypeCombobox.getValue() - 1.0f;
+			if (value == RANDOM) ui->widgets.speedScreen.show();
+			else ui->widgets.speedScreen.hide();
 		}
 
 		else if (controllerNr == SPIN_TYPE)
 		{
-			value = ui->spinTypeCombobox.getValue() - 1.0f;
-			if (value == RANDOM) ui->spinScreen.show();
-			else ui->spinScreen.hide();
+			value = ui->widgets.spinTypeCombobox.getValue() - 1.0f;
+			if (value == RANDOM) ui->widgets.spinScreen.show();
+			else ui->widgets.spinScreen.hide();
 		}
 
 		else
 		{
 			// Range widgets: Update parent dials as callbacks are overwritten
-			if (controllerNr == SPEED_RANGE) ui->speedDial.update();
-			if (controllerNr == SPIN_RANGE) ui->spinDial.update();
+			if (controllerNr == SPEED_RANGE) ui->widgets.speedDial.update();
+			if (controllerNr == SPIN_RANGE) ui->widgets.spinDial.update();
 
 			BWidgets::ValueableTyped<double>* valueable = dynamic_cast<BWidgets::ValueableTyped<double>*>(widget);
 			if (valueable) value = valueable->getValue();
@@ -378,29 +510,39 @@ void BAngrGUI::valueChangedCallback (BEvents::Event* event)
 void BAngrGUI::cursorDraggedCallback (BEvents::Event* event)
 {
 	if (!event) return;
-	Dot* widget = dynamic_cast<Dot*>(event->getWidget ());
+	BWidgets::Widget* widget = event->getWidget ();
 	if (!widget) return;
 	BAngrGUI* ui = dynamic_cast<BAngrGUI*> (widget->getMainWindow());
 	if (!ui) return;
-	if (widget != &ui->cursor) return;
+	if ((widget != &ui->widgets.cursor) && (widget != &ui->widgets.cursorGrip)) return;
 
-	double x = std::min (std::max (ui->cursor.getPosition().x + 0.5 * ui->cursor.getWidth(), 400.0), 600.0);
-	double y = std::min (std::max (ui->cursor.getPosition().y + 0.5 * ui->cursor.getHeight(), 180.0), 380.0);
+	double x = std::min (std::max (ui->widgets.cursor.getPosition().x + 0.5 * ui->widgets.cursor.getWidth(), 400.0), 600.0);
+	double y = std::min (std::max (ui->widgets.cursor.getPosition().y + 0.5 * ui->widgets.cursor.getHeight(), 180.0), 380.0);
 
-	ui->cursor.moveTo (x - 0.5 * ui->cursor.getWidth(), y - 0.5 * ui->cursor.getHeight());
-	ui->sendCursor();
+	ui->widgets.cursor.moveTo (x - 0.5 * ui->widgets.cursor.getWidth(), y - 0.5 * ui->widgets.cursor.getHeight());
+	ui->cursorPending = true;
+	ui->cursorDragged = true;
 }
 
 void BAngrGUI::cursorReleasedCallback (BEvents::Event* event)
 {
 	if (!event) return;
-	Dot* widget = dynamic_cast<Dot*> (event->getWidget ());
+	BWidgets::Widget* widget = event->getWidget ();
 	if (!widget) return;
 	BAngrGUI* ui = dynamic_cast<BAngrGUI*> (widget->getMainWindow());
 	if (!ui) return;
-	if (widget != &ui->cursor) return;
+	if ((widget != &ui->widgets.cursor) && (widget != &ui->widgets.cursorGrip)) return;
+
+	ui->cursorDragged = false;
+	ui->sendCursor (false);
 
-	ui->sendCursorOff();
+	// Continue from the released position
+	ui->cursorTrack = CursorTrack
+	{
+		(ui->widgets.cursor.getPosition().x + 0.5 * ui->widgets.cursor.getWidth() - 400.0) / 200.0,
+		(ui->widgets.cursor.getPosition().y + 0.5 * ui->widgets.cursor.getHeight() - 180.0) / 200.0,
+		0.0, 0.0, 0.0, 0.0, std::chrono::steady_clock::now()
+	};
 }
 
 void BAngrGUI::xregionClickedCallback (BEvents::Event* event)
@@ -459,6 +601,7 @@ static LV2UI_Handle instantiate (const LV2UI_Descriptor *descriptor, const char
 
 	ui->controller = controller;
 	ui->write_function = write_function;
+	ui->sendUiOn();
 	*widget = (LV2UI_Widget) ui->getNativeView ();
 	return (LV2UI_Handle) ui;
 }
@@ -479,7 +622,7 @@ static void portEvent(LV2UI_Handle ui, uint32_t port_index, uint32_t buffer_size
 static int callIdle (LV2UI_Handle ui)
 {
 	BAngrGUI* pluginGui = static_cast<BAngrGUI*> (ui);
-	if (pluginGui) pluginGui->handleEvents ();
+	if (pluginGui) pluginGui->handleIdle ();
 	return 0;
 }
 
@@ -24,6 +24,8 @@
 #include "BWidgets/BWidgets/Draws/Oops/definitions.hpp"
 
 #include <array>
+#include <chrono>
+#include <memory>
 #include <lv2/ui/ui.h>
 #include <lv2/atom/atom.h>
 #include <lv2/atom/forge.h>
@@ -32,17 +34,12 @@
 #include "BWidgets/BStyles/Types/Color.hpp"
 #include "BWidgets/BWidgets/Widget.hpp"
 #include "BWidgets/BWidgets/Window.hpp"
-#include "BWidgets/BWidgets/Knob.hpp"
-#include "BWidgets/BWidgets/Label.hpp"
-#include "BWidgets/BWidgets/ComboBox.hpp"
-#include "BWidgets/BWidgets/ValueHSlider.hpp"
-#include "BWidgets/BWidgets/Image.hpp"
-#include "BAngrDial.hpp"
-#include "BAngrRangeDial.hpp"
-#include "Dot.hpp"
+#include "BAngrStyles.hpp"
+#include "BAngrWidgets.hpp"
 #include "Definitions.hpp"
 #include "Ports.hpp"
 #include "Urids.hpp"
+#include "Telemetry.hpp"
 
 #ifndef LIMIT
 #define LIMIT(g , max) ((g) > (max) ? (max) : (g))
@@ -52,10 +49,16 @@
 #define WWW_BROWSER_CMD "x-www-browser"
 #endif
 
+#ifndef BANGR_GUI_DEFAULT_FRAME_RATE
+#define BANGR_GUI_DEFAULT_FRAME_RATE 60.0
+#endif
+
+#define BANGR_GUI_CURSOR_MAX_EXTRAPOLATION 0.25
+#define BANGR_GUI_CURSOR_CORRECTION_TIME 0.1
+
 #define XREGION_URL "http://www.airwindows.com/xregion/"
 #define HELP_URL "https://github.com/sjaehn/BAngr/blob/master/README.md"
 #define YT_URL "https://www.youtube.com/watch?v=-kWy_1UYazo"
-#define URID(x) (BURID(BANGR_GUI_URI x))
 
 class BAngrGUI : public BWidgets::Window
 {
@@ -63,11 +66,10 @@ public:
 	BAngrGUI (const char *bundle_path, const LV2_Feature *const *features, PuglNativeView parentWindow);
 	~BAngrGUI ();
 	void portEvent (uint32_t port_index, uint32_t buffer_size, uint32_t format, const void *buffer);
-	void sendCursor ();
-	void sendXCursor ();
-	void sendYCursor ();
-	void sendCursorOn ();
-	void sendCursorOff ();
+	void handleIdle ();
+	void sendCursor (const bool listen);
+	void sendUiOn ();
+	void sendUiOff ();
 	virtual void onConfigureRequest (BEvents::Event* event) override;
 
 	LV2UI_Controller controller;
@@ -84,210 +86,67 @@ private:
 
 	std::string pluginPath;
 
-	LV2_Atom_Forge forge;
-	BAngrURIs urids;
+	// Host URID map, mapped URIDs and forge. Resolved before the widgets
+	// are built.
 	LV2_URID_Map* map;
 	// LV2_URID_Unmap* unmap;
+	BAngrURIs urids;
+	LV2_Atom_Forge forge;
 
-	// Widgets
-	BWidgets::Image mContainer;
-	Dot cursor;
-	BWidgets::Label poweredLabel;
-	BWidgets::Button helpButton;
-	BWidgets::Button ytButton;
-	BWidgets::Knob bypassButton;
-	BWidgets::Label bypassLabel;
-    BAngrDial drywetDial;
-	BWidgets::Label drywetLabel;
-	BAngrRangeDial speedDial;
-	BWidgets::Label speedLabel;
-	BAngrRangeDial spinDial;
-	BWidgets::Label spinLabel;
-	BWidgets::Widget speedScreen;
-	BWidgets::Label speedFlexLabel;
-	BWidgets::ComboBox speedTypeCombobox;
-	BWidgets::ValueHSlider speedAmountSlider;
-	BWidgets::Widget spinScreen;
-	BWidgets::Label spinFlexLabel;
-	BWidgets::ComboBox spinTypeCombobox;
-	BWidgets::ValueHSlider spinAmountSlider;
-
-	struct Fx
+	static LV2_URID_Map* getURIDMap (const LV2_Feature* const* features);
+	static BAngrURIs mapURIs (LV2_URID_Map* m);
+
+	bool cursorPending;
+	bool cursorDragged;
+	BAngrTelemetry* telemetry;
+
+	double zoom;
+
+	// Frame pacing: handleIdle() only renders once per frame
+	double frameRate;
+	std::chrono::steady_clock::time_point nextFrame;
+
+	// Port events, recorded in portEvent() and applied once per frame
+	std::array<float, NR_CONTROLLERS> pendingControllers;
+	uint64_t pendingControllerMask;
+	float pendingXCursor;
+	float pendingYCursor;
+	bool pendingXCursorSet;
+	bool pendingYCursorSet;
+	float pendingXVelocity;
+	float pendingYVelocity;
+	bool pendingVelocitySet;
+	float pendingLoad;
+	float pendingPeak;
+	bool pendingLoadSet;
+	bool pendingPeakSet;
+	bool pendingTrail;
+	std::chrono::steady_clock::time_point nextTrailPoint;
+
+	/*
+	Cursor track for the display rate interpolation of sparse cursor
+	notifications: Last notified position and velocity, the displayed
+	offset to this position at the time of notification (fades out to
+	avoid jumps) and the time of notification.
+	 */
+	struct CursorTrack
 	{
-		BWidgets::Widget* container;
-		std::array<BAngrDial*, NR_PARAMS> paramDials;
-		std::array<BWidgets::Label*, NR_PARAMS> paramLabels;
+		double x, y;
+		double vx, vy;
+		double ox, oy;
+		std::chrono::steady_clock::time_point time;
 	};
-	std::array<Fx, NR_FX> fx;
-
-	// Controllers
-	std::array<BWidgets::Widget*, NR_CONTROLLERS> controllerWidgets;
-
-	// Definition of styles
-	BStyles::ColorMap fgColors = BStyles::ColorMap {{{1.0, 0.0, 0.0, 1.0}, {1.0, 0.3, 0.3, 1.0}, {0.7, 0.0, 0.0, 1.0}, {0.0, 0.0, 0.0, 0.0}}};
-	BStyles::ColorMap txColors = BStyles::ColorMap {{{0.8, 0.8, 0.8, 1.0}, {1.0, 1.0, 1.0, 1.0}, {0.5, 0.5, 0.5, 1.0}, {0.0, 0.0, 0.0, 0.0}}};
-	BStyles::ColorMap bgColors = BStyles::ColorMap {{{0.15, 0.15, 0.15, 1.0}, {0.3, 0.3, 0.3, 1.0}, {0.05, 0.05, 0.05, 1.0}, {0.0, 0.0, 0.0, 0.0}}};
-	BStyles::ColorMap noColors = BStyles::ColorMap {{{0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}}};
-
-	BStyles::Border border = {{fgColors[BStyles::Status::normal], 1.0}, 0.0, 2.0, 0.0};
-	BStyles::Border menuBorder = {{noColors[BStyles::Status::normal], 1.0}, 0.0, 0.0, 0.0};
-	BStyles::Border menuBorder2 = {{bgColors[BStyles::Status::normal], 1.0}, 0.0, 0.0, 0.0};
-	BStyles::Border btBorder = BStyles::Border (BStyles::Line (bgColors[BStyles::Status::normal].illuminate (BStyles::Color::darkened), 1.0), 0.0, 0.0, 3.0);
-	BStyles::Border labelBorder = {BStyles::noLine, 4.0, 0.0, 0.0};
-	BStyles::Fill widgetBg = BStyles::noFill;
-	BStyles::Fill screenBg = BStyles::Fill (BStyles::Color ({0.04, 0.0, 0.0, 0.8}));
-	BStyles::Font defaultFont =	BStyles::Font 
-	(
-		"Sans", 
-		CAIRO_FONT_SLANT_NORMAL, 
-		CAIRO_FONT_WEIGHT_NORMAL, 
-		12.0,
-		BStyles::Font::TextAlign::center, 
-		BStyles::Font::TextVAlign::middle
-	);
-
-	BStyles::Font smFont =	BStyles::Font 
-	(
-		"Sans", 
-		CAIRO_FONT_SLANT_NORMAL, 
-		CAIRO_FONT_WEIGHT_NORMAL, 
-		9.0,
-		BStyles::Font::TextAlign::center, 
-		BStyles::Font::TextVAlign::middle
-	);
+	CursorTrack cursorTrack;
 
-	BStyles::Font rFont =	BStyles::Font 
-	(
-		"Sans", 
-		CAIRO_FONT_SLANT_NORMAL, 
-		CAIRO_FONT_WEIGHT_NORMAL, 
-		12.0,
-		BStyles::Font::TextAlign::right, 
-		BStyles::Font::TextVAlign::middle
-	);
+	void applyPortEvents ();
+	void applyTelemetry ();
+	void setCursorTrack (const double xcursor, const double ycursor, const double vx, const double vy);
+	void getCursorEstimate (const std::chrono::steady_clock::time_point& time, double& xcursor, double& ycursor) const;
+	void animateCursor ();
+	void moveCursor (const double xcursor, const double ycursor);
 
-	BStyles::Font lFont =	BStyles::Font 
-	(
-		"Sans", 
-		CAIRO_FONT_SLANT_NORMAL, 
-		CAIRO_FONT_WEIGHT_NORMAL, 
-		12.0,
-		BStyles::Font::TextAlign::left, 
-		BStyles::Font::TextVAlign::middle
-	);
-
-	BStyles::Theme theme = BStyles::Theme
-	{
-		// main
-		{
-			URID ("/main"),
-			BStyles::Style 
-			({
-				{BURID(BSTYLES_STYLEPROPERTY_BACKGROUND_URI), BUtilities::makeAny<BStyles::Fill>(widgetBg)},
-				{BURID(BSTYLES_STYLEPROPERTY_BORDER_URI), BUtilities::makeAny<BStyles::Border>(BStyles::noBorder)}
-			})
-		},
-
-		// screen
-		{
-			URID ("/screen"), 
-			BStyles::Style 
-			({
-				{BURID(BSTYLES_STYLEPROPERTY_BACKGROUND_URI), BUtilities::makeAny<BStyles::Fill>(screenBg)},
-				{BURID(BSTYLES_STYLEPROPERTY_BORDER_URI), BUtilities::makeAny<BStyles::Border>(BStyles::noBorder)}
-			})
-		},
-
-		// button
-		{
-			URID ("/button"), 
-			BStyles::Style 
-			({
-				{BURID(BSTYLES_STYLEPROPERTY_BACKGROUND_URI), BUtilities::makeAny<BStyles::Fill>({BStyles::Fill(fgColors[BStyles::Status::normal])})},
-				{BURID(BSTYLES_STYLEPROPERTY_BGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(fgColors)},
-				{BURID(BSTYLES_STYLEPROPERTY_BORDER_URI), BUtilities::makeAny<BStyles::Border>(btBorder)}
-			})
-		},
-		
-		// button/label
-		{
-			URID ("/button/label"), 
-			BStyles::Style
-			({	
-				{BURID(BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font>(defaultFont)},
-				{BURID(BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(bgColors)}
-			})
-		},
-
-		// redbutton
-		{
-			URID ("/redbutton"), 
-			BStyles::Style 
-			({
-				{BURID(BSTYLES_STYLEPROPERTY_BGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(bgColors)},
-				{BURID(BSTYLES_STYLEPROPERTY_FGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(BStyles::reds)}
-			})
-		},
-
-		// halobutton
-		{
-			URID ("/halobutton"), 
-			BStyles::Style 
-			({
-				{BURID(BSTYLES_STYLEPROPERTY_BACKGROUND_URI), BUtilities::makeAny<BStyles::Fill>({BStyles::noFill})},
-				{BURID(BSTYLES_STYLEPROPERTY_BGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(noColors)},
-				{BURID(BSTYLES_STYLEPROPERTY_BORDER_URI), BUtilities::makeAny<BStyles::Border>(BStyles::noBorder)}
-			})
-		},
-
-		// label
-		{
-			URID ("/label"), 
-			BStyles::Style
-			({	
-				{BURID(BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font>(defaultFont)},
-				{BURID(BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(txColors)}
-			})
-		},
-
-		// rlabel
-		{
-			URID ("/rlabel"), 
-			BStyles::Style
-			({	
-				{BURID(BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font>(rFont)},
-				{BURID(BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(txColors)}
-			})
-		},
-
-		// dot
-		{
-			URID ("/dot"), 
-			BStyles::Style
-			({	
-				{BURID(BSTYLES_STYLEPROPERTY_FGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(txColors)}
-			})
-		},
-
-		// dial
-		{
-			URID ("/dial"), 
-			BStyles::Style
-			({	
-				{BURID(BSTYLES_STYLEPROPERTY_BGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(BStyles::darks)},
-				{BURID(BSTYLES_STYLEPROPERTY_FGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(fgColors)},
-				{URID ("/dial/label"), BUtilities::makeAny<BStyles::Style>
-					(
-						BStyles::Style
-						{
-							{BURID(BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font>(smFont)},
-							{BURID(BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(txColors)}
-						}
-					)}
-			})
-		}
-
-	};
+	// Widget tree, shared resources and controller links
+	BAngrWidgets widgets;
 };
 
 #endif /* BANGRGUI_HPP_ */
\ No newline at end of file
@@ -0,0 +1,157 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BANGRRESOURCES_HPP_
+#define BANGRRESOURCES_HPP_
+
+#include <cairo/cairo.h>
+#include <cmath>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "BAngrStyles.hpp"
+
+#define BANGR_RESOURCES_MAX_SCALES 4
+
+/**
+GUI resources shared by all B.Angr GUI instances of the host process: the
+decoded background image, pre-scaled copies of the background per zoom
+factor and the styles (theme, fonts). Resources are reference counted via
+acquire(). The most recently acquired resources are kept after the last
+instance is closed, thus re-opening an editor doesn't decode the image and
+resolve the theme again.
+ */
+class BAngrResources
+{
+public:
+	BAngrResources (const BAngrResources& that) = delete;
+	BAngrResources& operator= (const BAngrResources& that) = delete;
+
+	~BAngrResources ()
+	{
+		for (ScaledSurface& s : scaled_) cairo_surface_destroy (s.surface);
+		if (background_) cairo_surface_destroy (background_);
+	}
+
+	/**
+	Gets the shared resources for a background image file. Loads them if
+	not already in use.
+	 */
+	static std::shared_ptr<BAngrResources> acquire (const std::string& backgroundFile)
+	{
+		static std::mutex mutex;
+		static std::map<std::string, std::weak_ptr<BAngrResources>> instances;
+		static std::shared_ptr<BAngrResources> recent;
+
+		std::lock_guard<std::mutex> lock (mutex);
+		std::shared_ptr<BAngrResources> resources = instances[backgroundFile].lock();
+		if (!resources)
+		{
+			resources = std::shared_ptr<BAngrResources> (new BAngrResources (backgroundFile));
+			instances[backgroundFile] = resources;
+		}
+		recent = resources;
+		return resources;
+	}
+
+	const BAngrStyles& getStyles () const {return styles_;}
+
+	/**
+	Gets the background image pre-scaled to the provided scale. Scaled
+	copies are cached for the last BANGR_RESOURCES_MAX_SCALES scales.
+	@return	New reference to the surface or nullptr if the image is not
+			available. Release with cairo_surface_destroy().
+	 */
+	cairo_surface_t* getBackground (const double scale)
+	{
+		if ((!background_) || (scale <= 0.0)) return nullptr;
+
+		std::lock_guard<std::mutex> lock (mutex_);
+		++time_;
+		for (ScaledSurface& s : scaled_)
+		{
+			if (s.scale == scale)
+			{
+				s.lastUse = time_;
+				return cairo_surface_reference (s.surface);
+			}
+		}
+
+		const int w = cairo_image_surface_get_width (background_);
+		const int h = cairo_image_surface_get_height (background_);
+		cairo_surface_t* surface = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, ceil (w * scale), ceil (h * scale));
+		if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
+		{
+			cairo_surface_destroy (surface);
+			return nullptr;
+		}
+
+		cairo_t* cr = cairo_create (surface);
+		cairo_scale (cr, scale, scale);
+		cairo_set_source_surface (cr, background_, 0, 0);
+		cairo_pattern_set_filter (cairo_get_source (cr), CAIRO_FILTER_GOOD);
+		cairo_paint (cr);
+		cairo_destroy (cr);
+
+		// Replace the least recently used copy
+		if (scaled_.size() >= BANGR_RESOURCES_MAX_SCALES)
+		{
+			std::vector<ScaledSurface>::iterator lru = scaled_.begin();
+			for (std::vector<ScaledSurface>::iterator it = scaled_.begin(); it != scaled_.end(); ++it)
+			{
+				if (it->lastUse < lru->lastUse) lru = it;
+			}
+			cairo_surface_destroy (lru->surface);
+			scaled_.erase (lru);
+		}
+		scaled_.push_back (ScaledSurface {scale, surface, time_});
+		return cairo_surface_reference (surface);
+	}
+
+private:
+	BAngrResources (const std::string& backgroundFile) :
+		background_ (cairo_image_surface_create_from_png (backgroundFile.c_str())),
+		time_ (0)
+	{
+		if (cairo_surface_status (background_) != CAIRO_STATUS_SUCCESS)
+		{
+			cairo_surface_destroy (background_);
+			background_ = nullptr;
+		}
+	}
+
+	struct ScaledSurface
+	{
+		double scale;
+		cairo_surface_t* surface;
+		uint64_t lastUse;
+	};
+
+	BAngrStyles styles_;
+	cairo_surface_t* background_;
+	std::vector<ScaledSurface> scaled_;
+	uint64_t time_;
+	std::mutex mutex_;
+};
+
+#endif /* BANGRRESOURCES_HPP_ */
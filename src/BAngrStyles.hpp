@@ -0,0 +1,223 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BANGRSTYLES_HPP_
+#define BANGRSTYLES_HPP_
+
+#include "BWidgets/BStyles/Status.hpp"
+#include "BWidgets/BStyles/Types/Border.hpp"
+#include "BWidgets/BStyles/Types/Color.hpp"
+#include "BWidgets/BWidgets/Widget.hpp"
+#include "Definitions.hpp"
+
+#ifndef URID
+#define URID(x) (BURID(BANGR_GUI_URI x))
+#endif
+
+/**
+Definition of the colors, borders, fonts and the theme of the B.Angr GUI.
+ */
+struct BAngrStyles
+{
+	BStyles::ColorMap fgColors = BStyles::ColorMap {{{1.0, 0.0, 0.0, 1.0}, {1.0, 0.3, 0.3, 1.0}, {0.7, 0.0, 0.0, 1.0}, {0.0, 0.0, 0.0, 0.0}}};
+	BStyles::ColorMap txColors = BStyles::ColorMap {{{0.8, 0.8, 0.8, 1.0}, {1.0, 1.0, 1.0, 1.0}, {0.5, 0.5, 0.5, 1.0}, {0.0, 0.0, 0.0, 0.0}}};
+	BStyles::ColorMap bgColors = BStyles::ColorMap {{{0.15, 0.15, 0.15, 1.0}, {0.3, 0.3, 0.3, 1.0}, {0.05, 0.05, 0.05, 1.0}, {0.0, 0.0, 0.0, 0.0}}};
+	BStyles::ColorMap noColors = BStyles::ColorMap {{{0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}}};
+
+	BStyles::Border border = {{fgColors[BStyles::Status::normal], 1.0}, 0.0, 2.0, 0.0};
+	BStyles::Border menuBorder = {{noColors[BStyles::Status::normal], 1.0}, 0.0, 0.0, 0.0};
+	BStyles::Border menuBorder2 = {{bgColors[BStyles::Status::normal], 1.0}, 0.0, 0.0, 0.0};
+	BStyles::Border btBorder = BStyles::Border (BStyles::Line (bgColors[BStyles::Status::normal].illuminate (BStyles::Color::darkened), 1.0), 0.0, 0.0, 3.0);
+	BStyles::Border labelBorder = {BStyles::noLine, 4.0, 0.0, 0.0};
+	BStyles::Fill widgetBg = BStyles::noFill;
+	BStyles::Fill screenBg = BStyles::Fill (BStyles::Color ({0.04, 0.0, 0.0, 0.8}));
+	BStyles::Font defaultFont =	BStyles::Font 
+	(
+		"Sans", 
+		CAIRO_FONT_SLANT_NORMAL, 
+		CAIRO_FONT_WEIGHT_NORMAL, 
+		12.0,
+		BStyles::Font::TextAlign::center, 
+		BStyles::Font::TextVAlign::middle
+	);
+
+	BStyles::Font smFont =	BStyles::Font 
+	(
+		"Sans", 
+		CAIRO_FONT_SLANT_NORMAL, 
+		CAIRO_FONT_WEIGHT_NORMAL, 
+		9.0,
+		BStyles::Font::TextAlign::center, 
+		BStyles::Font::TextVAlign::middle
+	);
+
+	BStyles::Font rFont =	BStyles::Font 
+	(
+		"Sans", 
+		CAIRO_FONT_SLANT_NORMAL, 
+		CAIRO_FONT_WEIGHT_NORMAL, 
+		12.0,
+		BStyles::Font::TextAlign::right, 
+		BStyles::Font::TextVAlign::middle
+	);
+
+	BStyles::Font lFont =	BStyles::Font 
+	(
+		"Sans", 
+		CAIRO_FONT_SLANT_NORMAL, 
+		CAIRO_FONT_WEIGHT_NORMAL, 
+		12.0,
+		BStyles::Font::TextAlign::left, 
+		BStyles::Font::TextVAlign::middle
+	);
+
+	BStyles::Theme theme = BStyles::Theme
+	{
+		// main
+		{
+			URID ("/main"),
+			BStyles::Style 
+			({
+				{BURID(BSTYLES_STYLEPROPERTY_BACKGROUND_URI), BUtilities::makeAny<BStyles::Fill>(widgetBg)},
+				{BURID(BSTYLES_STYLEPROPERTY_BORDER_URI), BUtilities::makeAny<BStyles::Border>(BStyles::noBorder)}
+			})
+		},
+
+		// screen
+		{
+			URID ("/screen"), 
+			BStyles::Style 
+			({
+				{BURID(BSTYLES_STYLEPROPERTY_BACKGROUND_URI), BUtilities::makeAny<BStyles::Fill>(screenBg)},
+				{BURID(BSTYLES_STYLEPROPERTY_BORDER_URI), BUtilities::makeAny<BStyles::Border>(BStyles::noBorder)}
+			})
+		},
+
+		// button
+		{
+			URID ("/button"), 
+			BStyles::Style 
+			({
+				{BURID(BSTYLES_STYLEPROPERTY_BACKGROUND_URI), BUtilities::makeAny<BStyles::Fill>({BStyles::Fill(fgColors[BStyles::Status::normal])})},
+				{BURID(BSTYLES_STYLEPROPERTY_BGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(fgColors)},
+				{BURID(BSTYLES_STYLEPROPERTY_BORDER_URI), BUtilities::makeAny<BStyles::Border>(btBorder)}
+			})
+		},
+		
+		// button/label
+		{
+			URID ("/button/label"), 
+			BStyles::Style
+			({	
+				{BURID(BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font>(defaultFont)},
+				{BURID(BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(bgColors)}
+			})
+		},
+
+		// redbutton
+		{
+			URID ("/redbutton"), 
+			BStyles::Style 
+			({
+				{BURID(BSTYLES_STYLEPROPERTY_BGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(bgColors)},
+				{BURID(BSTYLES_STYLEPROPERTY_FGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(BStyles::reds)}
+			})
+		},
+
+		// halobutton
+		{
+			URID ("/halobutton"), 
+			BStyles::Style 
+			({
+				{BURID(BSTYLES_STYLEPROPERTY_BACKGROUND_URI), BUtilities::makeAny<BStyles::Fill>({BStyles::noFill})},
+				{BURID(BSTYLES_STYLEPROPERTY_BGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(noColors)},
+				{BURID(BSTYLES_STYLEPROPERTY_BORDER_URI), BUtilities::makeAny<BStyles::Border>(BStyles::noBorder)}
+			})
+		},
+
+		// label
+		{
+			URID ("/label"), 
+			BStyles::Style
+			({	
+				{BURID(BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font>(defaultFont)},
+				{BURID(BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(txColors)}
+			})
+		},
+
+		// rlabel
+		{
+			URID ("/rlabel"), 
+			BStyles::Style
+			({	
+				{BURID(BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font>(rFont)},
+				{BURID(BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(txColors)}
+			})
+		},
+
+		// dot
+		{
+			URID ("/dot"), 
+			BStyles::Style
+			({	
+				{BURID(BSTYLES_STYLEPROPERTY_FGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(txColors)}
+			})
+		},
+
+		// trail
+		{
+			URID ("/trail"), 
+			BStyles::Style
+			({	
+				{BURID(BSTYLES_STYLEPROPERTY_FGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(txColors)}
+			})
+		},
+
+		// meter
+		{
+			URID ("/meter"), 
+			BStyles::Style
+			({	
+				{BURID(BSTYLES_STYLEPROPERTY_FGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(fgColors)}
+			})
+		},
+
+		// dial
+		{
+			URID ("/dial"), 
+			BStyles::Style
+			({	
+				{BURID(BSTYLES_STYLEPROPERTY_BGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(BStyles::darks)},
+				{BURID(BSTYLES_STYLEPROPERTY_FGCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(fgColors)},
+				{URID ("/dial/label"), BUtilities::makeAny<BStyles::Style>
+					(
+						BStyles::Style
+						{
+							{BURID(BSTYLES_STYLEPROPERTY_FONT_URI), BUtilities::makeAny<BStyles::Font>(smFont)},
+							{BURID(BSTYLES_STYLEPROPERTY_TXCOLORS_URI), BUtilities::makeAny<BStyles::ColorMap>(txColors)}
+						}
+					)}
+			})
+		}
+
+	};
+};
+
+#endif /* BANGRSTYLES_HPP_ */
@@ -0,0 +1,221 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BANGRWIDGETS_HPP_
+#define BANGRWIDGETS_HPP_
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include "BWidgets/BWidgets/Widget.hpp"
+#include "BWidgets/BWidgets/Button.hpp"
+#include "BWidgets/BWidgets/Knob.hpp"
+#include "BWidgets/BWidgets/Label.hpp"
+#include "BWidgets/BWidgets/ComboBox.hpp"
+#include "BWidgets/BWidgets/ValueHSlider.hpp"
+#include "BWidgets/BWidgets/Supports/ValueableTyped.hpp"
+#include "BWidgets/BUtilities/Dictionary.hpp"
+#include "Background.hpp"
+#include "BAngrResources.hpp"
+#include "BAngrStyles.hpp"
+#include "BAngrDial.hpp"
+#include "BAngrRangeDial.hpp"
+#include "Dot.hpp"
+#include "CursorGrip.hpp"
+#include "FxPanel.hpp"
+#include "Trail.hpp"
+#include "LoadMeter.hpp"
+#include "Ports.hpp"
+
+#define BANGR_GUI_CURSOR_GRIP_RADIUS 20.0
+
+/**
+Widget tree of the B.Angr GUI. All widgets are members and are built,
+configured and packed into mContainer within the constructor. Callbacks,
+theme and the window are left to the owner. BAngrGUI and the GUI
+benchmarks build the same tree and thus the same construction work.
+@tparam W	Wrapper template for all widgets of the tree. Benchmarks use
+		it to instrument the widgets.
+ */
+template <template <class> class W = PlainWidget>
+class BasicBAngrWidgets
+{
+public:
+	// Shared background, theme and fonts
+	std::shared_ptr<BAngrResources> resources;
+
+	// Widgets
+	W<Background> mContainer;
+	W<Trail> trail;
+	W<Dot> cursor;
+	W<CursorGrip> cursorGrip;
+	W<BWidgets::Label> poweredLabel;
+	W<LoadMeter> loadMeter;
+	W<BWidgets::Label> loadLabel;
+	W<BWidgets::Button> helpButton;
+	W<BWidgets::Button> ytButton;
+
+	W<BWidgets::Knob> bypassButton;
+	W<BWidgets::Label> bypassLabel;
+	W<BAngrDial> drywetDial;
+	W<BWidgets::Label> drywetLabel;
+	W<BAngrRangeDial> speedDial;
+	W<BWidgets::Label> speedLabel;
+	W<BAngrRangeDial> spinDial;
+	W<BWidgets::Label> spinLabel;
+
+	W<BWidgets::Widget> speedScreen;
+	W<BWidgets::Label> speedFlexLabel;
+	W<BWidgets::ComboBox> speedTypeCombobox;
+	W<BWidgets::ValueHSlider> speedAmountSlider;
+	W<BWidgets::Widget> spinScreen;
+	W<BWidgets::Label> spinFlexLabel;
+	W<BWidgets::ComboBox> spinTypeCombobox;
+	W<BWidgets::ValueHSlider> spinAmountSlider;
+
+	std::array<W<BasicFxPanel<W>>, NR_FX> fx;
+
+	// Controllers
+	std::array<BWidgets::Widget*, NR_CONTROLLERS> controllerWidgets;
+	std::array<BWidgets::ValueableTyped<double>*, NR_CONTROLLERS> controllerValueables;
+
+	BasicBAngrWidgets (std::shared_ptr<BAngrResources> sharedResources) :
+		resources (sharedResources),
+		mContainer(0, 0, 1000, 560, resources, URID ("/bgimage")),
+		trail (396, 176, 208, 208, URID ("/trail")),
+		cursor (492, 272, 16, 16, URID ("/dot")),
+		cursorGrip (380, 160, 240, 240, &cursor, BANGR_GUI_CURSOR_GRIP_RADIUS, URID ("/grip")),
+		poweredLabel (720, 540, 250, 20, BDICT("Powered by Airwindows XRegion"), URID ("/rlabel")),
+		loadMeter (40, 536, 80, 6, URID ("/meter"), BDICT ("DSP load")),
+		loadLabel (30, 540, 100, 20, BDICT ("DSP load"), URID ("/label")),
+		helpButton (918, 508, 24, 24, false, false, URID ("/halobutton"), BDICT ("Help")),
+		ytButton (948, 508, 24, 24, false, false, URID ("/halobutton"), BDICT ("Preview")),
+		bypassButton (900, 30, 20, 20, 2, true, false, URID ("/redbutton"), BDICT ("Bypass")),
+		bypassLabel (880, 60, 60, 20, BDICT ("Bypass"), URID ("/label")),
+		drywetDial (940, 20, 40, 40, 1.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Dry/wet")),
+		drywetLabel (930, 60, 60, 20, BDICT ("Dry/wet"), URID ("/label")),
+		speedDial (370, 460, 60, 60, 0.5, 0.5, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Speed")),
+		speedLabel (350, 520, 100, 20, BDICT("Speed"), URID("/label")),
+		spinDial (570, 460, 60, 60, 0.0, 0.0, -1.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Spin")),
+		spinLabel (550, 520, 100, 20, BDICT("Spin"), URID("/label")),
+		speedScreen (180, 480, 100, 35, URID("/screen")),
+		speedFlexLabel (220, 520, 100, 20, BDICT("Flexibility"), URID("/label")),
+		speedTypeCombobox (280, 490, 80, 20, 0, -120, 80, 120, {BDICT("Random"), BDICT("Level"), BDICT("Lows"), BDICT("Mids"), BDICT("Highs")}, 1, URID("/menu")),
+		speedAmountSlider (200, 485, 80, 20, 0.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Speed")),
+		spinScreen (640, 480, 100, 35, URID("/screen")),
+		spinFlexLabel (680, 520, 100, 20, BDICT("Flexibility"), URID("/label")),
+		spinTypeCombobox (740, 490, 80, 20, 0, -120, 80, 120, {BDICT("Random"), BDICT("Level"), BDICT("Lows"), BDICT("Mids"), BDICT("Highs")}, 1, URID("/menu")),
+		spinAmountSlider (660, 485, 80, 20, 0.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Spin")),
+		fx
+		{{
+			W<BasicFxPanel<W>> (20, 100, URID ("/widget")),
+			W<BasicFxPanel<W>> (20, 300, URID ("/widget")),
+			W<BasicFxPanel<W>> (680, 300, URID ("/widget")),
+			W<BasicFxPanel<W>> (680, 100, URID ("/widget"))
+		}}
+	{
+		// Link controllers
+		controllerWidgets[BYPASS] = &bypassButton;
+		controllerWidgets[DRY_WET] = &drywetDial;
+		controllerWidgets[SPEED] = &speedDial;
+		controllerWidgets[SPEED_RANGE] = &speedDial.range;
+		controllerWidgets[SPEED_TYPE] = &speedTypeCombobox;
+		controllerWidgets[SPEED_AMOUNT] = &speedAmountSlider;
+		controllerWidgets[SPIN] = &spinDial;
+		controllerWidgets[SPIN_RANGE] = &spinDial.range;
+		controllerWidgets[SPIN_TYPE] = &spinTypeCombobox;
+		controllerWidgets[SPIN_AMOUNT] = &spinAmountSlider;
+
+		for (int i = 0; i < NR_FX; ++i)
+		{
+			for (int j = 0; j < NR_PARAMS; ++j)
+			{
+				controllerWidgets[FX + i * NR_PARAMS + j] = &fx[i].dials[j];
+			}
+		}
+
+		// Resolve value interfaces once, combo boxes are handled separately
+		for (int i = 0; i < NR_CONTROLLERS; ++i)
+		{
+			controllerValueables[i] = ((i == SPEED_TYPE) || (i == SPIN_TYPE) ? nullptr : dynamic_cast<BWidgets::ValueableTyped<double>*> (controllerWidgets[i]));
+		}
+
+		// Configure widgets
+		cursor.setDraggable (true);
+		drywetDial.setClickable(false);
+		drywetDial.setScrollable(true);
+		drywetDial.label.hide();
+		speedDial.setClickable(false);
+		speedDial.setScrollable(true);
+		spinDial.setClickable(false);
+		spinDial.setScrollable(true);
+		speedAmountSlider.setClickable(false);
+		speedAmountSlider.setScrollable(true);
+		spinAmountSlider.setClickable(false);
+		spinAmountSlider.setScrollable(true);
+
+		// Pack widgets
+		for (BWidgets::Widget* w : packOrder()) mContainer.add (w);
+	}
+
+	BasicBAngrWidgets (const BasicBAngrWidgets& that) = delete;
+	BasicBAngrWidgets& operator= (const BasicBAngrWidgets& that) = delete;
+
+	/**
+	Moves the cursor dot to a cursor position, snapped to the device pixel
+	grid. Moves within a pixel don't change the display and are skipped.
+	@param xcursor	Cursor x position [0, 1].
+	@param ycursor	Cursor y position [0, 1].
+	@param zoom	Zoom factor of mContainer.
+	@return		True if the dot was moved, otherwise false.
+	 */
+	bool moveCursor (const double xcursor, const double ycursor, const double zoom)
+	{
+		const double px = (zoom > 0.0 ? 1.0 / zoom : 1.0);
+		const double x = px * round (((400.0 + xcursor * 200.0) - 0.5 * cursor.getWidth()) / px);
+		const double y = px * round (((180.0 + ycursor * 200.0) - 0.5 * cursor.getHeight()) / px);
+		if ((x == cursor.getPosition().x) && (y == cursor.getPosition().y)) return false;
+		cursor.moveTo (x, y);
+		return true;
+	}
+
+	/**
+	Direct children of mContainer in z-order (bottom first).
+	 */
+	std::array<BWidgets::Widget*, NR_FX + 24> packOrder ()
+	{
+		return
+		{{
+			&fx[0], &fx[1], &fx[2], &fx[3],
+			&bypassButton, &bypassLabel, &drywetDial, &drywetLabel,
+			&speedDial, &speedLabel, &spinDial, &spinLabel,
+			&speedFlexLabel, &speedTypeCombobox, &speedAmountSlider,
+			&spinFlexLabel, &spinTypeCombobox, &spinAmountSlider,
+			&speedScreen, &spinScreen,
+			&trail, &cursorGrip, &cursor,
+			&poweredLabel, &loadMeter, &loadLabel,
+			&helpButton, &ytButton
+		}};
+	}
+};
+
+typedef BasicBAngrWidgets<> BAngrWidgets;
+
+#endif /* BANGRWIDGETS_HPP_ */
@@ -0,0 +1,89 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BACKGROUND_HPP_
+#define BACKGROUND_HPP_
+
+#include "BWidgets/BWidgets/Widget.hpp"
+#include "BAngrResources.hpp"
+#include "LayerCache.hpp"
+#include <memory>
+
+/**
+Container widget showing the shared background image. The image is taken
+pre-scaled to the zoom factor from the shared resources and is thus only
+copied, not rescaled, on redraw.
+ */
+class Background : public BWidgets::Widget
+{
+public:
+	Background (const double x, const double y, const double width, const double height,
+				std::shared_ptr<BAngrResources> resources,
+				uint32_t urid = BUTILITIES_URID_UNKNOWN_URID, std::string title = "") :
+		Widget (x, y, width, height, urid, title),
+		resources_ (resources)
+	{}
+
+	virtual Widget* clone () const override 
+	{
+		Widget* f = new Background (0, 0, 0, 0, resources_, urid_, title_);
+		f->copy (this);
+		return f;
+	}
+
+	inline void copy (const Background* that)
+	{
+		resources_ = that->resources_;
+		Widget::copy (that);
+	}
+
+protected:
+	virtual void draw (const BUtilities::Area<>& area) override
+	{
+		if ((!cairoSurface()) || (cairo_surface_status (cairoSurface()) != CAIRO_STATUS_SUCCESS)) return;
+
+		// Draw super class widget elements first
+		Widget::draw (area);
+
+		if (!resources_) return;
+		const double scale = LayerCache::getScale (cairoSurface());
+		cairo_surface_t* image = resources_->getBackground (scale);
+		if (!image) return;
+
+		cairo_t* cr = cairo_create (cairoSurface());
+		if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+		{
+			// Limit cairo-drawing area
+			cairo_rectangle (cr, area.getX (), area.getY (), area.getWidth (), area.getHeight ());
+			cairo_clip (cr);
+
+			// 1:1 copy in device pixels
+			cairo_scale (cr, 1.0 / scale, 1.0 / scale);
+			cairo_set_source_surface (cr, image, 0, 0);
+			cairo_paint (cr);
+		}
+		cairo_destroy (cr);
+		cairo_surface_destroy (image);
+	}
+
+	std::shared_ptr<BAngrResources> resources_;
+};
+
+#endif /* BACKGROUND_HPP_ */
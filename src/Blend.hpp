@@ -0,0 +1,49 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BLEND_HPP_
+#define BLEND_HPP_
+
+#include "Ports.hpp"
+
+/**
+Blends the parameters of the four FX at the corners of the cursor pad
+(FX1: x = 0, y = 0; FX2: x = 0, y = 1; FX3: x = 1, y = 1; FX4: x = 1, y = 0)
+bilinearly for the provided cursor position.
+@param x	Cursor x position [0.0, 1.0].
+@param y	Cursor y position [0.0, 1.0].
+@param fx	NR_FX * NR_PARAMS FX parameters.
+@param params	Target for NR_PARAMS blended parameters.
+ */
+inline void blendParams (const float x, const float y, const float* fx, float* params)
+{
+	for (int i = 0; i < NR_PARAMS; ++i)
+	{
+		params[i] =
+		(
+			((1.0f - x) * (1.0f - y) * fx[0 * NR_PARAMS + i]) +
+			((1.0f - x) * y * fx[1 * NR_PARAMS + i]) +
+			(x * y * fx[2 * NR_PARAMS + i]) +
+			(x * (1.0 - y) * fx[3 * NR_PARAMS + i])
+		);
+	}
+}
+
+#endif /* BLEND_HPP_ */
@@ -50,6 +50,18 @@ public:
 		highpass.clear();
 	}
 
+	void writeCheckpoint (CheckpointWriter& writer) const
+	{
+		lowpass.writeCheckpoint (writer);
+		highpass.writeCheckpoint (writer);
+	}
+
+	void readCheckpoint (CheckpointReader& reader)
+	{
+		lowpass.readCheckpoint (reader);
+		highpass.readCheckpoint (reader);
+	}
+
 
 protected:
 	ButterworthLowPassFilter lowpass;
@@ -23,6 +23,7 @@
 
 #include <cmath>
 #include <array>
+#include "Checkpoint.hpp"
 
 #define BUTTERWORTH_MAXORDER 16
 
@@ -64,6 +65,21 @@ public:
 		buffer0.fill (0.0f);
 		buffer1.fill (0.0f);
 		buffer2.fill (0.0f);
+		output = 0.0f;
+	}
+
+	void writeCheckpoint (CheckpointWriter& writer) const
+	{
+		writer.put (buffer1.data(), buffer1.size());
+		writer.put (buffer2.data(), buffer2.size());
+		writer.put (output);
+	}
+
+	void readCheckpoint (CheckpointReader& reader)
+	{
+		reader.get (buffer1.data(), buffer1.size());
+		reader.get (buffer2.data(), buffer2.size());
+		reader.get (output);
 	}
 
 
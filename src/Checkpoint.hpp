@@ -0,0 +1,105 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CHECKPOINT_HPP_
+#define CHECKPOINT_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#define BANGR_CHECKPOINT_MAGIC 0x72676e41u	// "Angr"
+#define BANGR_CHECKPOINT_VERSION 2u
+
+/**
+Sequential writer for binary DSP snapshots. Values are stored in native
+byte order. Writing into a nullptr buffer or beyond the end of the buffer
+only advances the position, thus the writer can also be used to determine
+the required buffer size.
+ */
+class CheckpointWriter
+{
+public:
+	CheckpointWriter (uint8_t* data = nullptr, const size_t size = 0) :
+		data (data),
+		size (size),
+		pos (0)
+	{}
+
+	template <class T>
+	void put (const T& value) {putRaw (&value, sizeof (T));}
+
+	template <class T>
+	void put (const T* values, const size_t n) {putRaw (values, n * sizeof (T));}
+
+	void putRaw (const void* src, const size_t n)
+	{
+		if (data && (pos + n <= size)) memcpy (data + pos, src, n);
+		pos += n;
+	}
+
+	size_t getPosition () const {return pos;}
+	bool isValid () const {return data && (pos <= size);}
+
+private:
+	uint8_t* data;
+	size_t size;
+	size_t pos;
+};
+
+/**
+Sequential reader for binary DSP snapshots written by CheckpointWriter.
+Reading beyond the end of the buffer leaves the target untouched and
+invalidates the reader.
+ */
+class CheckpointReader
+{
+public:
+	CheckpointReader (const uint8_t* data, const size_t size) :
+		data (data),
+		size (size),
+		pos (0),
+		valid (data != nullptr)
+	{}
+
+	template <class T>
+	void get (T& value) {getRaw (&value, sizeof (T));}
+
+	template <class T>
+	void get (T* values, const size_t n) {getRaw (values, n * sizeof (T));}
+
+	void getRaw (void* dest, const size_t n)
+	{
+		if (valid && (pos + n <= size)) memcpy (dest, data + pos, n);
+		else valid = false;
+		pos += n;
+	}
+
+	size_t getPosition () const {return pos;}
+	bool isValid () const {return valid;}
+
+private:
+	const uint8_t* data;
+	size_t size;
+	size_t pos;
+	bool valid;
+};
+
+#endif /* CHECKPOINT_HPP_ */
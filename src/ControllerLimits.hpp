@@ -62,4 +62,32 @@ const Limit controllerLimits [NR_CONTROLLERS] =
     {-1.0, 1.0, 0.0}    // Pan
 };
 
+/**
+Default controller values as defined in BAngr.ttl.
+ */
+const float controllerDefaults[NR_CONTROLLERS] =
+{
+	0.0f, 1.0f,					// Bypass, dry/wet
+	0.5f, 0.25f, 0.0f, 0.5f,			// Speed, range, type, amount
+	0.0f, 0.1f, 0.0f, 0.5f,				// Spin, range, type, amount
+	0.5f, 0.2f, 0.1f, 1.0f, 1.0f, 0.0f,		// FX1
+	0.5f, 0.7f, 0.8f, 1.0f, 1.0f, 0.0f,		// FX2
+	0.75f, 0.5f, 0.8f, 0.5f, 1.0f, 0.5f,		// FX3
+	0.5f, 0.2f, 0.5f, 0.2f, 1.0f, -0.5f		// FX4
+};
+
+/**
+Controller port symbols as defined in BAngr.ttl.
+ */
+const char* const controllerSymbols[NR_CONTROLLERS] =
+{
+	"bypass", "dry_wet",
+	"speed", "speed_range", "speed_flexibility_type", "speed_flexibility_amount",
+	"spin", "spin_range", "spin_flexibility_type", "spin_flexibility_amount",
+	"fx1_gain", "fx1_first", "fx1_last", "fx1_nuke", "fx1_mix", "fx1_pan",
+	"fx2_gain", "fx2_first", "fx2_last", "fx2_nuke", "fx2_mix", "fx2_pan",
+	"fx3_gain", "fx3_first", "fx3_last", "fx3_nuke", "fx3_mix", "fx3_pan",
+	"fx4_gain", "fx4_first", "fx4_last", "fx4_nuke", "fx4_mix", "fx4_pan"
+};
+
 #endif /* CONTROLLERLIMITS_HPP_ */
\ No newline at end of file
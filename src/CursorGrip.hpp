@@ -0,0 +1,105 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CURSORGRIP_HPP_
+#define CURSORGRIP_HPP_
+
+#include "BWidgets/BEvents/Event.hpp"
+#include "BWidgets/BEvents/PointerEvent.hpp"
+#include "BWidgets/BWidgets/Widget.hpp"
+#include "BWidgets/BWidgets/Supports/Clickable.hpp"
+#include "BWidgets/BWidgets/Supports/Draggable.hpp"
+#include "Dot.hpp"
+
+/**
+Invisible, static grip area behind the cursor dot. The dot widget is kept
+tight around the dot to limit the damaged area per move (see Dot). Button
+presses within radius around the dot center grab the dot and the
+following drags move it. Other presses are ignored. Must be a sibling of
+the dot.
+ */
+class CursorGrip :	public BWidgets::Widget,
+			public BWidgets::Clickable,
+			public BWidgets::Draggable
+{
+public:
+	CursorGrip () : CursorGrip (0, 0, 0, 0, nullptr, 0.0, BUTILITIES_URID_UNKNOWN_URID, "") {}
+	CursorGrip (const double x, const double y, const double width, const double height, Dot* dot, const double radius,
+			uint32_t urid = BUTILITIES_URID_UNKNOWN_URID, std::string title = "") :
+			Widget (x, y, width, height, urid, title),
+			BWidgets::Clickable(),
+			BWidgets::Draggable(),
+			dot_ (dot),
+			radius_ (radius),
+			grabbed_ (false)
+	{}
+
+	virtual Widget* clone () const override 
+	{
+		Widget* f = new CursorGrip (0, 0, 0, 0, dot_, radius_, urid_, title_);
+		f->copy (this);
+		return f;
+	}
+
+	inline void copy (const CursorGrip* that)
+	{
+		dot_ = that->dot_;
+		radius_ = that->radius_;
+		grabbed_ = false;
+		Draggable::operator= (*that);
+		Clickable::operator= (*that);
+		Widget::copy (that);
+	}
+
+	virtual void onButtonPressed (BEvents::Event* event) override
+	{
+		BEvents::PointerEvent* pev = dynamic_cast<BEvents::PointerEvent*> (event);
+		grabbed_ = false;
+		if ((!pev) || (!dot_)) return;
+
+		const double dx = getPosition().x + pev->getPosition().x - (dot_->getPosition().x + 0.5 * dot_->getWidth());
+		const double dy = getPosition().y + pev->getPosition().y - (dot_->getPosition().y + 0.5 * dot_->getHeight());
+		grabbed_ = (dx * dx + dy * dy <= radius_ * radius_);
+		if (grabbed_) Clickable::onButtonPressed (event);
+	}
+
+	virtual void onPointerDragged (BEvents::Event* event) override
+	{
+		BEvents::PointerEvent* pev = dynamic_cast<BEvents::PointerEvent*> (event);
+		if ((!pev) || (!dot_) || (!grabbed_)) return;
+
+		dot_->moveTo (dot_->getPosition().x + pev->getDelta().x, dot_->getPosition().y + pev->getDelta().y);
+		Draggable::onPointerDragged (event);
+	}
+
+	virtual void onButtonReleased (BEvents::Event* event) override
+	{
+		if (!grabbed_) return;
+		grabbed_ = false;
+		Clickable::onButtonReleased (event);
+	}
+
+protected:
+	Dot* dot_;
+	double radius_;
+	bool grabbed_;
+};
+
+#endif /* CURSORGRIP_HPP_ */
@@ -0,0 +1,130 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef CURSORMESSAGE_HPP_
+#define CURSORMESSAGE_HPP_
+
+#include <cstdint>
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include "Urids.hpp"
+
+/**
+Checks if the provided number of bytes can be appended to the forge
+buffer. Forges writing to a sink are assumed to have unlimited space.
+ */
+inline bool forgeHasSpace (const LV2_Atom_Forge* forge, const uint32_t size)
+{
+	return forge->sink || (forge->offset + size <= forge->size);
+}
+
+/**
+Forges a cursor notification object containing only the provided
+coordinates and optionally the cursor velocity.
+@param forge	Forge, set to an atom sequence.
+@param urids	Mapped URIDs.
+@param frame	Frame time of the event.
+@param sendX	True, if the x coordinate shall be sent.
+@param x	Cursor x position.
+@param sendY	True, if the y coordinate shall be sent.
+@param y	Cursor y position.
+@param sendVelocity	True, if the velocity shall be sent.
+@param vx	Cursor x velocity in units per second.
+@param vy	Cursor y velocity in units per second.
+@return		True on success, otherwise false (buffer overflow). Nothing is
+		written if the event doesn't fit and the caller can retry.
+ */
+inline bool forgeCursor
+(
+	LV2_Atom_Forge* forge, const BAngrURIs& urids, const int64_t frame,
+	const bool sendX, const float x, const bool sendY, const float y,
+	const bool sendVelocity = false, const float vx = 0.0f, const float vy = 0.0f
+)
+{
+	// Nothing is written unless the complete event fits
+	const uint32_t propertySize = sizeof (LV2_Atom_Property_Body) - sizeof (LV2_Atom) + lv2_atom_pad_size (sizeof (LV2_Atom_Float));
+	const uint32_t nrProperties = (sendX ? 1 : 0) + (sendY ? 1 : 0) + (sendVelocity ? 2 : 0);
+	if (!forgeHasSpace (forge, sizeof (int64_t) + sizeof (LV2_Atom_Object) + nrProperties * propertySize)) return false;
+
+	LV2_Atom_Forge_Frame objFrame;
+	if (!lv2_atom_forge_frame_time (forge, frame)) return false;
+	if (!lv2_atom_forge_object (forge, &objFrame, 0, urids.bangr_cursor)) return false;
+	if (sendX)
+	{
+		if (!lv2_atom_forge_key (forge, urids.bangr_xcursor)) return false;
+		if (!lv2_atom_forge_float (forge, x)) return false;
+	}
+	if (sendY)
+	{
+		if (!lv2_atom_forge_key (forge, urids.bangr_ycursor)) return false;
+		if (!lv2_atom_forge_float (forge, y)) return false;
+	}
+	if (sendVelocity)
+	{
+		if (!lv2_atom_forge_key (forge, urids.bangr_xvelocity)) return false;
+		if (!lv2_atom_forge_float (forge, vx)) return false;
+		if (!lv2_atom_forge_key (forge, urids.bangr_yvelocity)) return false;
+		if (!lv2_atom_forge_float (forge, vy)) return false;
+	}
+	lv2_atom_forge_pop (forge, &objFrame);
+	return true;
+}
+
+/**
+Packs a cursor position into 16 bit x (low word) and 16 bit y (high word).
+ */
+inline uint32_t packTrailPoint (const float x, const float y)
+{
+	const uint32_t qx = (x <= 0.0f ? 0 : (x >= 1.0f ? 65535 : uint32_t (x * 65535.0f + 0.5f)));
+	const uint32_t qy = (y <= 0.0f ? 0 : (y >= 1.0f ? 65535 : uint32_t (y * 65535.0f + 0.5f)));
+	return qx | (qy << 16);
+}
+
+inline float unpackTrailX (const uint32_t point) {return float (point & 0xffff) * (1.0f / 65535.0f);}
+
+inline float unpackTrailY (const uint32_t point) {return float (point >> 16) * (1.0f / 65535.0f);}
+
+/**
+Forges a batch of cursor trail points as one object with an atom vector
+of packed points (see packTrailPoint()), oldest first.
+@param forge	Forge, set to an atom sequence.
+@param urids	Mapped URIDs.
+@param frame	Frame time of the event.
+@param points	Packed points.
+@param n	Number of points.
+@return		True on success, otherwise false (buffer overflow). Nothing is
+		written if the event doesn't fit and the caller can retry.
+ */
+inline bool forgeTrail (LV2_Atom_Forge* forge, const BAngrURIs& urids, const int64_t frame, const uint32_t* points, const uint32_t n)
+{
+	// Nothing is written unless the complete event fits
+	const uint32_t vectorSize = lv2_atom_pad_size (sizeof (LV2_Atom_Vector) + n * sizeof (int32_t));
+	if (!forgeHasSpace (forge, sizeof (int64_t) + sizeof (LV2_Atom_Object) + sizeof (LV2_Atom_Property_Body) - sizeof (LV2_Atom) + vectorSize)) return false;
+
+	LV2_Atom_Forge_Frame objFrame;
+	if (!lv2_atom_forge_frame_time (forge, frame)) return false;
+	if (!lv2_atom_forge_object (forge, &objFrame, 0, urids.bangr_trail)) return false;
+	if (!lv2_atom_forge_key (forge, urids.bangr_trailPoints)) return false;
+	if (!lv2_atom_forge_vector (forge, sizeof (int32_t), urids.atom_Int, n, points)) return false;
+	lv2_atom_forge_pop (forge, &objFrame);
+	return true;
+}
+
+#endif /* CURSORMESSAGE_HPP_ */
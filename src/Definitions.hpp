@@ -24,4 +24,8 @@
 #define BANGR_URI "https://www.jahnichen.de/plugins/lv2/BAngr"
 #define BANGR_GUI_URI "https://www.jahnichen.de/plugins/lv2/BAngr#gui"
 
+// Cursor trail: points per second and size of the DSP trail ring (power of 2)
+#define BANGR_TRAIL_RATE 50.0
+#define BANGR_TRAIL_SIZE 128
+
 #endif /* DEFINITIONS_HPP_ */
@@ -0,0 +1,59 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef DENORMALGUARD_HPP_
+#define DENORMALGUARD_HPP_
+
+#if defined(__SSE__)
+#include <xmmintrin.h>
+#endif
+
+/**
+Flushes denormals to zero (FTZ, DAZ) within its scope. Saves the floating
+point control state on construction and restores the host setting on
+destruction. No-op without SSE.
+ */
+class DenormalGuard
+{
+public:
+	DenormalGuard () :
+		mxcsr (0)
+	{
+#if defined(__SSE__)
+		mxcsr = _mm_getcsr();
+		_mm_setcsr (mxcsr | 0x8040);	// FTZ (bit 15) and DAZ (bit 6)
+#endif
+	}
+
+	DenormalGuard (const DenormalGuard& that) = delete;
+	DenormalGuard& operator= (const DenormalGuard& that) = delete;
+
+	~DenormalGuard ()
+	{
+#if defined(__SSE__)
+		_mm_setcsr (mxcsr);
+#endif
+	}
+
+private:
+	unsigned int mxcsr;
+};
+
+#endif /* DENORMALGUARD_HPP_ */
@@ -23,8 +23,13 @@
 #include "BWidgets/BStyles/Types/Color.hpp"
 #include "BWidgets/BWidgets/Frame.hpp"
 #include "BWidgets/BWidgets/Supports/Clickable.hpp"
+#include "LayerCache.hpp"
 #include <cmath>
 
+/**
+Cursor dot. The widget area is kept tight around the dot as each move
+damages the old and the new widget area.
+ */
 class Dot : public BWidgets::Frame,
 			public BWidgets::Clickable
 {
@@ -82,15 +87,36 @@ protected:
 				BStyles::Color fg = getFgColors()[getStatus()]; 
 				fg.illuminate (BStyles::Color::normalLighted);
 
-				cairo_set_line_width (cr, 0.0);
-				cairo_set_source_rgba (cr, CAIRO_RGBA (fg));
-				cairo_arc (cr,xc, yc, 0.125 * d, 0.0, 2.0 * M_PI);
-				cairo_close_path (cr);
-				cairo_fill (cr);
+				// Dot sprite from cache, (re-)draw on zoom, resize or style changes
+				const double scale = LayerCache::getScale (cairoSurface());
+				const uint64_t key = LayerCache::makeKey ({xc, yc, d, fg.red, fg.green, fg.blue, fg.alpha});
+				if (!sprite_.isValid (getWidth(), getHeight(), scale, key))
+				{
+					cairo_t* lcr = sprite_.create (getWidth(), getHeight(), scale, key);
+					if (lcr)
+					{
+						drawDot (lcr, xc, yc, d, fg);
+						cairo_destroy (lcr);
+					}
+				}
+
+				if (sprite_.isValid (getWidth(), getHeight(), scale, key)) sprite_.paint (cr);
+				else drawDot (cr, xc, yc, d, fg);
 			}
 			cairo_destroy (cr);
 		}
 	}
+
+	static void drawDot (cairo_t* cr, const double xc, const double yc, const double d, const BStyles::Color& fg)
+	{
+		cairo_set_line_width (cr, 0.0);
+		cairo_set_source_rgba (cr, CAIRO_RGBA (fg));
+		cairo_arc (cr,xc, yc, 0.3125 * d, 0.0, 2.0 * M_PI);
+		cairo_close_path (cr);
+		cairo_fill (cr);
+	}
+
+	LayerCache sprite_;
 };
 
 #endif /* DOT_HPP_ */
@@ -0,0 +1,105 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef DSPLOAD_HPP_
+#define DSPLOAD_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+
+#define DSPLOAD_AVERAGE_TIME 1.0
+#define DSPLOAD_PEAK_RELEASE_TIME 3.0
+
+/**
+Measures the time spent in run() relative to the real-time budget of the
+processed block (frames / rate). The monotonic clock is read once at the
+begin and once at the end of each block.
+ */
+class DspLoad
+{
+public:
+	DspLoad (const double rate);
+
+	/**
+	Starts the measurement of a block.
+	 */
+	void begin ();
+
+	/**
+	Ends the measurement of a block and updates average and peak load.
+	@param frames	Number of frames processed in the block.
+	 */
+	void end (const uint32_t frames);
+
+	/**
+	Gets the average load, exponentially smoothed over
+	DSPLOAD_AVERAGE_TIME seconds of audio.
+	@return	Load in percent of the real-time budget.
+	 */
+	float getLoad () const;
+
+	/**
+	Gets the peak load. Peaks decay over DSPLOAD_PEAK_RELEASE_TIME
+	seconds of audio.
+	@return	Load in percent of the real-time budget.
+	 */
+	float getPeak () const;
+
+private:
+	double rate;
+	timespec t0;
+	float load;
+	float peak;
+};
+
+inline DspLoad::DspLoad (const double rate) :
+	rate (rate),
+	t0 {0, 0},
+	load (0.0f),
+	peak (0.0f)
+{}
+
+inline void DspLoad::begin ()
+{
+	clock_gettime (CLOCK_MONOTONIC, &t0);
+}
+
+inline void DspLoad::end (const uint32_t frames)
+{
+	if (frames == 0) return;
+
+	timespec t1;
+	clock_gettime (CLOCK_MONOTONIC, &t1);
+	const double elapsed = double (t1.tv_sec - t0.tv_sec) + 1e-9 * double (t1.tv_nsec - t0.tv_nsec);
+	const double budget = double (frames) / rate;
+	const float blockLoad = 100.0 * elapsed / budget;
+
+	const float a = 1.0f - expf (-budget / DSPLOAD_AVERAGE_TIME);
+	load += a * (blockLoad - load);
+	peak *= expf (-budget / DSPLOAD_PEAK_RELEASE_TIME);
+	if (blockLoad > peak) peak = blockLoad;
+}
+
+inline float DspLoad::getLoad () const {return load;}
+
+inline float DspLoad::getPeak () const {return peak;}
+
+#endif /* DSPLOAD_HPP_ */
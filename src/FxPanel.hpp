@@ -0,0 +1,103 @@
+/* B.Angr
+ * Glitch effect sequencer LV2 plugin
+ *
+ * Copyright (C) 2021 - 2022 by Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef FXPANEL_HPP_
+#define FXPANEL_HPP_
+
+#include "BWidgets/BWidgets/Widget.hpp"
+#include "BWidgets/BWidgets/Label.hpp"
+#include "BWidgets/BUtilities/Dictionary.hpp"
+#include "BAngrDial.hpp"
+#include "BAngrStyles.hpp"
+#include "Ports.hpp"
+#include <array>
+
+/**
+Default widget wrapper: The widget type itself.
+ */
+template <class T> using PlainWidget = T;
+
+/**
+Panel with the parameter dials and labels of one FX. All child widgets are
+members and are built and packed in a single pass within the constructor
+without any heap allocation of their own.
+@tparam W	Wrapper template for the child widgets. Benchmarks use it to
+		instrument the widgets of the GUI tree.
+ */
+template <template <class> class W = PlainWidget>
+class BasicFxPanel : public BWidgets::Widget
+{
+public:
+	std::array<W<BAngrDial>, NR_PARAMS> dials;
+	std::array<W<BWidgets::Label>, NR_PARAMS> labels;
+
+	BasicFxPanel (const double x, const double y, uint32_t urid = BUTILITIES_URID_UNKNOWN_URID, std::string title = "") :
+		Widget (x, y, 300, 160, urid, title),
+		dials
+		{{
+			W<BAngrDial> (0, 10, 60, 60, 0.5, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Gain")),
+			W<BAngrDial> (80, 10, 60, 60, 0.5, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("First")),
+			W<BAngrDial> (160, 10, 60, 60, 0.5, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Last")),
+			W<BAngrDial> (240, 10, 60, 60, 0.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Nuke")),
+			W<BAngrDial> (40, 70, 60, 60, 1.0, 0.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Mix")),
+			W<BAngrDial> (200, 70, 60, 60, 0.0, -1.0, 1.0, 0.0, BNOTRANSFERD, BNOTRANSFERD, BDOUBLE_TO_STRING, BSTRING_TO_DOUBLE, URID ("/dial"), BDICT ("Pan"))
+		}},
+		labels
+		{{
+			W<BWidgets::Label> (0, 70, 60, 20, BDICT ("Gain"), URID ("/label")),
+			W<BWidgets::Label> (80, 70, 60, 20, BDICT ("First"), URID ("/label")),
+			W<BWidgets::Label> (160, 70, 60, 20, BDICT ("Last"), URID ("/label")),
+			W<BWidgets::Label> (240, 70, 60, 20, BDICT ("Nuke"), URID ("/label")),
+			W<BWidgets::Label> (40, 130, 60, 20, BDICT ("Mix"), URID ("/label")),
+			W<BWidgets::Label> (200, 130, 60, 20, BDICT ("Pan"), URID ("/label"))
+		}}
+	{
+		for (int i = 0; i < NR_PARAMS; ++i)
+		{
+			dials[i].setClickable (false);
+			dials[i].setScrollable (true);
+			add (&dials[i]);
+			add (&labels[i]);
+		}
+	}
+
+	BasicFxPanel (const BasicFxPanel& that) = delete;
+	BasicFxPanel& operator= (const BasicFxPanel& that) = delete;
+
+	virtual Widget* clone () const override 
+	{
+		BasicFxPanel* f = new BasicFxPanel (getPosition().x, getPosition().y, urid_, title_);
+		f->copy (this);
+		return f;
+	}
+
+	inline void copy (const BasicFxPanel* that)
+	{
+		for (int i = 0; i < NR_PARAMS; ++i)
+		{
+			dials[i].copy (&that->dials[i]);
+			labels[i].copy (&that->labels[i]);
+		}
+		Widget::copy (that);
+	}
+};
+
+typedef BasicFxPanel<> FxPanel;
+
+#endif /* FXPANEL_HPP_ */
@@ -0,0 +1,162 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef LAYERCACHE_HPP_
+#define LAYERCACHE_HPP_
+
+#include <cairo/cairo.h>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+
+/**
+Image surface cache for the static parts of a widget (backgrounds, scales,
+sprites). A layer is (re-)drawn only if its size, its device scale (zoom)
+or its key (colors, geometry) changed. Copies of a cache are empty.
+ */
+class LayerCache
+{
+public:
+	LayerCache () : surface_ (nullptr), width_ (0.0), height_ (0.0), scale_ (0.0), key_ (0) {}
+	LayerCache (const LayerCache& that) : LayerCache () {}
+	LayerCache& operator= (const LayerCache& that)
+	{
+		clear ();
+		return *this;
+	}
+	~LayerCache () {clear ();}
+
+	/**
+	Creates a key from the parameters the layer depends on.
+	 */
+	static uint64_t makeKey (const std::initializer_list<double> values)
+	{
+		// FNV-1a
+		uint64_t key = 14695981039346656037ull;
+		for (const double v : values)
+		{
+			uint64_t bits;
+			memcpy (&bits, &v, sizeof (bits));
+			for (int i = 0; i < 8; ++i) key = (key ^ ((bits >> (8 * i)) & 0xff)) * 1099511628211ull;
+		}
+		return key;
+	}
+
+	/**
+	Gets the device scale (zoom) of a widget surface.
+	 */
+	static double getScale (cairo_surface_t* surface)
+	{
+		double sx = 1.0;
+		double sy = 1.0;
+		if (surface) cairo_surface_get_device_scale (surface, &sx, &sy);
+		return (sx > sy ? sx : sy);
+	}
+
+	/**
+	Checks if the cached layer matches.
+	 */
+	bool isValid (const double width, const double height, const double scale, const uint64_t key) const
+	{
+		return surface_ && (width == width_) && (height == height_) && (scale == scale_) && (key == key_);
+	}
+
+	/**
+	Replaces the cached layer by an empty one and returns a cairo context
+	in widget coordinates to draw it. The caller destroys the context. The
+	surface is cleared and reused if only the key changed (e.g., layers
+	redrawn each frame).
+	@return	Cairo context or nullptr on failure.
+	 */
+	cairo_t* create (const double width, const double height, const double scale, const uint64_t key)
+	{
+		if (surface_ && (width == width_) && (height == height_) && (scale == scale_))
+		{
+			cairo_t* cr = cairo_create (surface_);
+			if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+			{
+				cairo_save (cr);
+				cairo_set_operator (cr, CAIRO_OPERATOR_CLEAR);
+				cairo_paint (cr);
+				cairo_restore (cr);
+				key_ = key;
+				return cr;
+			}
+			cairo_destroy (cr);
+		}
+
+		clear ();
+		if ((width < 1.0) || (height < 1.0) || (scale <= 0.0)) return nullptr;
+
+		surface_ = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, ceil (width * scale), ceil (height * scale));
+		if (cairo_surface_status (surface_) != CAIRO_STATUS_SUCCESS)
+		{
+			clear ();
+			return nullptr;
+		}
+		cairo_surface_set_device_scale (surface_, scale, scale);
+		width_ = width;
+		height_ = height;
+		scale_ = scale;
+		key_ = key;
+
+		cairo_t* cr = cairo_create (surface_);
+		if (cairo_status (cr) != CAIRO_STATUS_SUCCESS)
+		{
+			cairo_destroy (cr);
+			clear ();
+			return nullptr;
+		}
+		return cr;
+	}
+
+	/**
+	Composites the cached layer at the widget position x, y. Respects the
+	clip of cr.
+	 */
+	void paint (cairo_t* cr, const double x = 0.0, const double y = 0.0) const
+	{
+		if (!surface_) return;
+		cairo_save (cr);
+		cairo_set_source_surface (cr, surface_, x, y);
+		cairo_paint (cr);
+		cairo_restore (cr);
+	}
+
+	void clear ()
+	{
+		if (surface_) cairo_surface_destroy (surface_);
+		surface_ = nullptr;
+		width_ = 0.0;
+		height_ = 0.0;
+		scale_ = 0.0;
+		key_ = 0;
+	}
+
+private:
+	cairo_surface_t* surface_;
+	double width_;
+	double height_;
+	double scale_;
+	uint64_t key_;
+};
+
+#endif /* LAYERCACHE_HPP_ */
@@ -0,0 +1,138 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef LOADMETER_HPP_
+#define LOADMETER_HPP_
+
+#include "BWidgets/BStyles/Types/Color.hpp"
+#include "BWidgets/BWidgets/Frame.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+Horizontal bar meter for the DSP load. The bar shows the average load and
+a tick marks the peak load, both in percent of the real-time budget.
+ */
+class LoadMeter : public BWidgets::Frame
+{
+public:
+	LoadMeter () : LoadMeter (0, 0, 0, 0, BUTILITIES_URID_UNKNOWN_URID, "") {}
+	LoadMeter (uint32_t urid = BUTILITIES_URID_UNKNOWN_URID, std::string title = "") :
+			LoadMeter (0, 0, 0, 0, urid, title) {}
+	LoadMeter (const double x, const double y, const double width, const double height, 
+			uint32_t urid = BUTILITIES_URID_UNKNOWN_URID, std::string title = "") :
+			Frame (x, y, width, height, urid, title),
+			load_ (0.0f),
+			peak_ (0.0f)
+	{}
+
+	virtual Widget* clone () const override 
+	{
+		Widget* f = new LoadMeter (urid_, title_);
+		f->copy (this);
+		return f;
+	}
+
+	inline void copy (const LoadMeter* that)
+	{
+		load_ = that->load_;
+		peak_ = that->peak_;
+		Frame::copy (that);
+	}
+
+	/**
+	Sets the average load.
+	@param load	Load in percent.
+	 */
+	void setLoad (const float load)
+	{
+		// Redraw only on visible changes
+		if (fabsf (load - load_) < 0.5f) return;
+		load_ = load;
+		update ();
+	}
+
+	/**
+	Sets the peak load.
+	@param peak	Load in percent.
+	 */
+	void setPeak (const float peak)
+	{
+		if (fabsf (peak - peak_) < 0.5f) return;
+		peak_ = peak;
+		update ();
+	}
+
+	float getLoad () const {return load_;}
+
+	float getPeak () const {return peak_;}
+
+protected:
+	float load_;
+	float peak_;
+
+	virtual void draw (const BUtilities::Area<>& area) override
+	{
+		if ((!cairoSurface()) || (cairo_surface_status (cairoSurface()) != CAIRO_STATUS_SUCCESS)) return;
+
+		// Draw super class widget elements first
+		Widget::draw (area);
+
+		const double x0 = getXOffset ();
+		const double y0 = getYOffset ();
+		const double h = getEffectiveHeight ();
+		const double w = getEffectiveWidth ();
+
+		if ((w > 0) && (h > 0))
+		{
+			cairo_t* cr = cairo_create (cairoSurface());
+
+			if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+			{
+				// Limit cairo-drawing area
+				cairo_rectangle (cr, area.getX (), area.getY (), area.getWidth (), area.getHeight ());
+				cairo_clip (cr);
+
+				BStyles::Color fg = getFgColors()[getStatus()];
+				BStyles::Color bg = fg;
+				bg.illuminate (BStyles::Color::darkened);
+				const double lw = std::min (std::max (0.01 * load_, 0.0), 1.0) * w;
+				const double pw = std::min (std::max (0.01 * peak_, 0.0), 1.0) * w;
+
+				cairo_set_line_width (cr, 0.0);
+				cairo_set_source_rgba (cr, CAIRO_RGBA (bg));
+				cairo_rectangle (cr, x0, y0, w, h);
+				cairo_fill (cr);
+
+				cairo_set_source_rgba (cr, CAIRO_RGBA (fg));
+				cairo_rectangle (cr, x0, y0, lw, h);
+				cairo_fill (cr);
+
+				fg.illuminate (BStyles::Color::normalLighted);
+				cairo_set_source_rgba (cr, CAIRO_RGBA (fg));
+				cairo_rectangle (cr, x0 + std::max (pw - 2.0, 0.0), y0, std::min (2.0, w), h);
+				cairo_fill (cr);
+			}
+			cairo_destroy (cr);
+		}
+	}
+};
+
+#endif /* LOADMETER_HPP_ */
@@ -0,0 +1,179 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef OFFLINEHOST_HPP_
+#define OFFLINEHOST_HPP_
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <lv2/core/lv2.h>
+#include <lv2/urid/urid.h>
+#include <lv2/atom/atom.h>
+#include <lv2/atom/forge.h>
+#include "BAngr.hpp"
+#include "ControllerLimits.hpp"
+#include "Ports.hpp"
+#include "Urids.hpp"
+
+/**
+Minimal in-process host for running the B.Angr DSP without an LV2 host,
+e.g. for benchmarks and offline processing. Provides urid:map, an atom
+sequence for control messages, a notification buffer and the controller
+ports. All buffers are allocated in the constructor, thus run() doesn't
+allocate.
+ */
+class OfflineHost
+{
+public:
+	OfflineHost (const double rate, const uint32_t controlSize = 65536, const uint32_t notifySize = 65536) :
+		controllers {0.0f},
+		mapFeature {this, staticMap},
+		feature {LV2_URID__map, &mapFeature},
+		features {&feature, nullptr},
+		controlBuffer (controlSize / sizeof (uint64_t) + 1),
+		notifyBuffer (notifySize / sizeof (uint64_t) + 1),
+		plugin (nullptr)
+	{
+		for (int i = 0; i < NR_CONTROLLERS; ++i) controllers[i] = controllerDefaults[i];
+		::getURIs (&mapFeature, &urids);
+		lv2_atom_forge_init (&forge, &mapFeature);
+
+		plugin = new BAngr (rate, features);
+		plugin->connect_port (CONTROL, controlBuffer.data());
+		plugin->connect_port (NOTIFY, notifyBuffer.data());
+		for (int i = 0; i < NR_CONTROLLERS; ++i) plugin->connect_port (CONTROLLERS + i, &controllers[i]);
+		clearEvents();
+	}
+
+	OfflineHost (const OfflineHost& that) = delete;
+	OfflineHost& operator= (const OfflineHost& that) = delete;
+
+	~OfflineHost () {delete plugin;}
+
+	BAngr& getPlugin () {return *plugin;}
+	const BAngrURIs& getURIs () const {return urids;}
+	LV2_URID map (const char* uri) {return staticMap (this, uri);}
+
+	/**
+	Sends a combined cursor message as the GUI does.
+	 */
+	bool sendCursor (const int64_t frame, const float x, const float y, const bool listen)
+	{
+		LV2_Atom_Forge_Frame objFrame;
+		if (!lv2_atom_forge_frame_time (&forge, frame)) return false;
+		if (!lv2_atom_forge_object (&forge, &objFrame, 0, urids.bangr_cursor)) return false;
+		lv2_atom_forge_key (&forge, urids.bangr_xcursor);
+		lv2_atom_forge_float (&forge, x);
+		lv2_atom_forge_key (&forge, urids.bangr_ycursor);
+		lv2_atom_forge_float (&forge, y);
+		lv2_atom_forge_key (&forge, urids.bangr_listen);
+		lv2_atom_forge_bool (&forge, listen);
+		lv2_atom_forge_pop (&forge, &objFrame);
+		return true;
+	}
+
+	/**
+	Sends a patch:Set message for a float property.
+	 */
+	bool sendPatchSet (const int64_t frame, const LV2_URID property, const float value)
+	{
+		LV2_Atom_Forge_Frame objFrame;
+		if (!lv2_atom_forge_frame_time (&forge, frame)) return false;
+		if (!lv2_atom_forge_object (&forge, &objFrame, 0, urids.patch_Set)) return false;
+		lv2_atom_forge_key (&forge, urids.patch_property);
+		lv2_atom_forge_urid (&forge, property);
+		lv2_atom_forge_key (&forge, urids.patch_value);
+		lv2_atom_forge_float (&forge, value);
+		lv2_atom_forge_pop (&forge, &objFrame);
+		return true;
+	}
+
+	/**
+	Sends an empty object message of the provided type (e.g., uiOn).
+	 */
+	bool sendMessage (const int64_t frame, const LV2_URID otype)
+	{
+		LV2_Atom_Forge_Frame objFrame;
+		if (!lv2_atom_forge_frame_time (&forge, frame)) return false;
+		if (!lv2_atom_forge_object (&forge, &objFrame, 0, otype)) return false;
+		lv2_atom_forge_pop (&forge, &objFrame);
+		return true;
+	}
+
+	/**
+	Runs the plugin. Pending control messages are delivered and cleared
+	afterwards.
+	 */
+	void run (const float* input1, const float* input2, float* output1, float* output2, const uint32_t nframes)
+	{
+		lv2_atom_forge_pop (&forge, &sequenceFrame);
+
+		LV2_Atom_Sequence* notify = reinterpret_cast<LV2_Atom_Sequence*> (notifyBuffer.data());
+		notify->atom.type = 0;
+		notify->atom.size = notifyBuffer.size() * sizeof (uint64_t) - sizeof (LV2_Atom);
+
+		plugin->connect_port (AUDIO_IN_1, const_cast<float*> (input1));
+		plugin->connect_port (AUDIO_IN_2, const_cast<float*> (input2));
+		plugin->connect_port (AUDIO_OUT_1, output1);
+		plugin->connect_port (AUDIO_OUT_2, output2);
+		plugin->run (nframes);
+
+		clearEvents();
+	}
+
+	const LV2_Atom_Sequence* getNotifications () const
+	{
+		return reinterpret_cast<const LV2_Atom_Sequence*> (notifyBuffer.data());
+	}
+
+	float controllers[NR_CONTROLLERS];
+
+private:
+	LV2_URID_Map mapFeature;
+	LV2_Feature feature;
+	const LV2_Feature* features[2];
+	std::map<std::string, LV2_URID> uris;
+	BAngrURIs urids;
+	LV2_Atom_Forge forge;
+	LV2_Atom_Forge_Frame sequenceFrame;
+	std::vector<uint64_t> controlBuffer;
+	std::vector<uint64_t> notifyBuffer;
+	BAngr* plugin;
+
+	void clearEvents ()
+	{
+		lv2_atom_forge_set_buffer (&forge, reinterpret_cast<uint8_t*> (controlBuffer.data()), controlBuffer.size() * sizeof (uint64_t));
+		lv2_atom_forge_sequence_head (&forge, &sequenceFrame, 0);
+	}
+
+	static LV2_URID staticMap (LV2_URID_Map_Handle handle, const char* uri)
+	{
+		OfflineHost* host = static_cast<OfflineHost*> (handle);
+		std::map<std::string, LV2_URID>::const_iterator it = host->uris.find (uri);
+		if (it != host->uris.end()) return it->second;
+		const LV2_URID urid = host->uris.size() + 1;
+		host->uris[uri] = urid;
+		return urid;
+	}
+};
+
+#endif /* OFFLINEHOST_HPP_ */
@@ -52,7 +52,11 @@ enum BAngrPortIndex
 	PARAM_PAN	= 5,
 	NR_PARAMS	= 6,
 
-	NR_CONTROLLERS	= FX + NR_FX * NR_PARAMS
+	NR_CONTROLLERS	= FX + NR_FX * NR_PARAMS,
+
+	DSP_LOAD	= CONTROLLERS + NR_CONTROLLERS,
+	DSP_PEAK	= DSP_LOAD + 1,
+	SEED		= DSP_PEAK + 1
 };
 
 enum BAngrFlexibilityIndex
@@ -5,6 +5,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <ctime>
+#include "Checkpoint.hpp"
 
 /**
 Minimal implementation of a realtime-safe random class
@@ -35,6 +36,25 @@ public:
     template<class T = float>
     T rand_range(const T from, const T to);
 
+    /**
+    Re-seeds the generator. Generators seeded with the same value produce
+    the same sequence.
+    @param value    Seed.
+    */
+    void seed (const uint64_t value);
+
+    /**
+    Writes the generator state to a DSP snapshot.
+    @param writer   Snapshot writer.
+    */
+    void writeCheckpoint (CheckpointWriter& writer) const;
+
+    /**
+    Restores the generator state from a DSP snapshot.
+    @param reader   Snapshot reader.
+    */
+    void readCheckpoint (CheckpointReader& reader);
+
 private:
 	uint64_t __state;
 	uint64_t __inc;
@@ -63,6 +83,27 @@ inline T RTRand::rand_range(const T from, const T to)
     return from + (from != to) * __rand_u32() / static_cast<T>(4294967295.0 / (to - from));
 }
 
+inline void RTRand::seed (const uint64_t value)
+{
+    __state = 0;
+    __inc = (0xda3e39cb94b95bdbULL << 1) | 1;
+    __rand_u32 ();
+    __state += value;
+    __rand_u32 ();
+}
+
+inline void RTRand::writeCheckpoint (CheckpointWriter& writer) const
+{
+    writer.put (__state);
+    writer.put (__inc);
+}
+
+inline void RTRand::readCheckpoint (CheckpointReader& reader)
+{
+    reader.get (__state);
+    reader.get (__inc);
+}
+
 inline uint32_t RTRand::__rand_u32 ()
 {
     uint64_t ostate = __state;
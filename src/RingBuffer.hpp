@@ -0,0 +1,85 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef RINGBUFFER_HPP_
+#define RINGBUFFER_HPP_
+
+#include <atomic>
+#include <array>
+#include <cstdint>
+
+/**
+Lock-free, wait-free single producer / single consumer ring buffer with a
+fixed capacity. Doesn't allocate. push() may only be called from the
+producer thread, pop() only from the consumer thread.
+@tparam T	Trivially copyable element type.
+@tparam N	Capacity, must be a power of two.
+ */
+template <class T, uint32_t N>
+class RingBuffer
+{
+	static_assert ((N >= 2) && ((N & (N - 1)) == 0), "RingBuffer capacity must be a power of two");
+
+public:
+	RingBuffer () :
+		head (0),
+		tail (0)
+	{}
+
+	/**
+	Adds an element. Called by the producer.
+	@param value	Element.
+	@return		True on success, false if the buffer is full.
+	 */
+	bool push (const T& value)
+	{
+		const uint32_t h = head.load (std::memory_order_relaxed);
+		if (h - tail.load (std::memory_order_acquire) >= N) return false;
+		data[h & (N - 1)] = value;
+		head.store (h + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	Takes the oldest element. Called by the consumer.
+	@param value	Target.
+	@return		True on success, false if the buffer is empty.
+	 */
+	bool pop (T& value)
+	{
+		const uint32_t t = tail.load (std::memory_order_relaxed);
+		if (head.load (std::memory_order_acquire) == t) return false;
+		value = data[t & (N - 1)];
+		tail.store (t + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	Gets the number of elements available for the consumer.
+	 */
+	uint32_t size () const {return head.load (std::memory_order_acquire) - tail.load (std::memory_order_acquire);}
+
+private:
+	std::array<T, N> data;
+	alignas (64) std::atomic<uint32_t> head;
+	alignas (64) std::atomic<uint32_t> tail;
+};
+
+#endif /* RINGBUFFER_HPP_ */
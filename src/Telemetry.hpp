@@ -0,0 +1,73 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef TELEMETRY_HPP_
+#define TELEMETRY_HPP_
+
+#include <atomic>
+#include <cstdint>
+#include <lv2/core/lv2.h>
+#include "Definitions.hpp"
+#include "RingBuffer.hpp"
+
+#define BANGR_TELEMETRY_URI BANGR_URI "#telemetry"
+#define BANGR_TELEMETRY_SIZE 128
+
+/**
+DSP state sample, taken once per run() block. Contains the cursor, the
+modulation, the band levels of the speed and spin followers, and the DSP
+load statistics (same values as the DSP_LOAD and DSP_PEAK ports).
+ */
+struct TelemetrySample
+{
+	uint32_t frames;
+	float xcursor;
+	float ycursor;
+	float speed;
+	float spin;
+	float speedlevel;
+	float spinlevel;
+	float load;
+	float peak;
+};
+
+/**
+Direct DSP to GUI channel for hosts which run plugin and GUI in the same
+process. The ring is single producer single consumer. Thus only one GUI
+can attach at a time: It claims the channel by setting attached from
+false to true and releases it on close. The DSP only fills the ring while
+a GUI is attached. All other GUIs use atom messages.
+ */
+struct BAngrTelemetry
+{
+	RingBuffer<TelemetrySample, BANGR_TELEMETRY_SIZE> ring;
+	std::atomic<bool> attached {false};
+};
+
+/**
+Extension data interface provided via BANGR_TELEMETRY_URI. Requires
+instance-access and data-access in the GUI.
+ */
+struct BAngrTelemetryInterface
+{
+	BAngrTelemetry* (*getTelemetry) (LV2_Handle instance);
+};
+
+#endif /* TELEMETRY_HPP_ */
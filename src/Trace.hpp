@@ -0,0 +1,248 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef TRACE_HPP_
+#define TRACE_HPP_
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#define BANGR_TRACE_SHM_PREFIX "/bangr-trace-"
+#define BANGR_TRACE_MAGIC 0x63617254u	// "Trac"
+#define BANGR_TRACE_VERSION 2u
+#define BANGR_TRACE_SIZE 4096		// Records, must be a power of two
+#define BANGR_TRACE_INTERVAL 16		// Trace one of BANGR_TRACE_INTERVAL blocks
+
+enum TraceStage
+{
+	TRACE_EVENTS		= 0,	// Event and controller handling
+	TRACE_FILTERS		= 1,	// Analysis filters
+	TRACE_FOLLOWERS		= 2,	// Level followers
+	TRACE_CURSOR		= 3,	// Cursor physics
+	TRACE_BLEND		= 4,	// FX interpolation
+	TRACE_COEFFICIENTS	= 5,	// XRegion coefficient setup
+	TRACE_KERNEL		= 6,	// XRegion kernel
+	TRACE_MIX		= 7,	// Output mixing
+	NR_TRACE_STAGES		= 8
+};
+
+const char* const traceStageNames[NR_TRACE_STAGES] =
+{
+	"events", "filters", "followers", "cursor", "blend", "coefficients", "kernel", "mix"
+};
+
+/**
+Per-block trace record. seq is set to 0 while the record is written and to
+the record number + 1 afterwards, thus readers can detect torn records.
+ */
+struct TraceRecord
+{
+	std::atomic<uint64_t> seq;
+	uint32_t frames;
+	uint64_t ticks[NR_TRACE_STAGES];
+};
+
+/**
+Trace ring buffer shared between the DSP (single writer) and any number of
+readers. Old records are overwritten. The clock pair (startTicks,
+startTime) is taken on creation. Readers calibrate the ticks against the
+steady clock with a second pair taken by themselves.
+ */
+struct TraceBuffer
+{
+	uint32_t magic;
+	uint32_t version;
+	uint32_t nrStages;
+	uint32_t size;
+	uint32_t interval;
+	double rate;
+	uint64_t startTicks;
+	int64_t startTime;
+	std::atomic<uint64_t> writeCount;
+	TraceRecord records[BANGR_TRACE_SIZE];
+};
+
+static_assert (std::atomic<uint64_t>::is_always_lock_free, "Trace buffer requires lock-free 64 bit atomics");
+
+/**
+Reads the cycle counter (x86) or the monotonic clock in ns (others).
+ */
+inline uint64_t traceClock ()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+Reads the steady clock in ns.
+ */
+inline int64_t traceTime ()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds> (std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/**
+Cycle counter probes for the DSP stages. Stage times are accumulated per
+block using lap(), which charges the ticks since the previous probe to the
+provided stage. Only one of BANGR_TRACE_INTERVAL blocks is traced, the
+probes of all other blocks return without reading the clock. The per-block
+totals are written to a TraceBuffer in POSIX shared memory
+(BANGR_TRACE_SHM_PREFIX + pid + instance number) which is allocated by
+open().
+
+The engine only creates a Tracer if built with BANGR_TRACE. The flag also
+enables the TRACE_* probe macros, which take a pointer to the Tracer.
+Without open(), all probes are no-ops.
+ */
+class Tracer
+{
+public:
+	Tracer () :
+		buffer (nullptr),
+		name {0},
+		ticks {0},
+		last (0),
+		blockCount (0),
+		active (false)
+	{}
+
+	Tracer (const Tracer& that) = delete;
+	Tracer& operator= (const Tracer& that) = delete;
+
+	~Tracer ()
+	{
+		if (buffer)
+		{
+			munmap (buffer, sizeof (TraceBuffer));
+			shm_unlink (name);
+		}
+	}
+
+	/**
+	Creates the shared memory trace buffer. Not real-time safe.
+	@param rate	Sample rate in Hz.
+	 */
+	void open (const double rate)
+	{
+		if (buffer) return;
+
+		static std::atomic<int> instances (0);
+		snprintf (name, sizeof (name), BANGR_TRACE_SHM_PREFIX "%d-%d", int (getpid()), instances++);
+
+		const int fd = shm_open (name, O_CREAT | O_RDWR | O_TRUNC, 0644);
+		if (fd < 0) return;
+		if (ftruncate (fd, sizeof (TraceBuffer)) == 0)
+		{
+			void* ptr = mmap (nullptr, sizeof (TraceBuffer), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (ptr != MAP_FAILED) buffer = static_cast<TraceBuffer*> (ptr);
+		}
+		close (fd);
+
+		if (!buffer)
+		{
+			shm_unlink (name);
+			return;
+		}
+
+		memset (static_cast<void*> (buffer), 0, sizeof (TraceBuffer));
+		buffer->magic = BANGR_TRACE_MAGIC;
+		buffer->version = BANGR_TRACE_VERSION;
+		buffer->nrStages = NR_TRACE_STAGES;
+		buffer->size = BANGR_TRACE_SIZE;
+		buffer->interval = BANGR_TRACE_INTERVAL;
+		buffer->rate = rate;
+		buffer->startTime = traceTime();
+		buffer->startTicks = traceClock();
+	}
+
+	void setRate (const double rate)
+	{
+		if (buffer) buffer->rate = rate;
+	}
+
+	void begin ()
+	{
+		active = buffer && (blockCount++ % BANGR_TRACE_INTERVAL == 0);
+		if (!active) return;
+
+		memset (ticks, 0, sizeof (ticks));
+		last = traceClock();
+	}
+
+	void lap (const TraceStage stage)
+	{
+		if (!active) return;
+
+		const uint64_t t = traceClock();
+		ticks[stage] += t - last;
+		last = t;
+	}
+
+	void end (const uint32_t frames)
+	{
+		if (!active) return;
+
+		const uint64_t n = buffer->writeCount.load (std::memory_order_relaxed);
+		TraceRecord& r = buffer->records[n & (BANGR_TRACE_SIZE - 1)];
+		r.seq.store (0, std::memory_order_relaxed);
+		std::atomic_thread_fence (std::memory_order_release);
+		r.frames = frames;
+		memcpy (r.ticks, ticks, sizeof (ticks));
+		r.seq.store (n + 1, std::memory_order_release);
+		buffer->writeCount.store (n + 1, std::memory_order_release);
+		active = false;
+	}
+
+private:
+	TraceBuffer* buffer;
+	char name[64];
+	uint64_t ticks[NR_TRACE_STAGES];
+	uint64_t last;
+	uint64_t blockCount;
+	bool active;
+};
+
+#ifdef BANGR_TRACE
+
+#define TRACE_BEGIN(tracer) (tracer)->begin()
+#define TRACE_LAP(tracer, stage) (tracer)->lap (stage)
+#define TRACE_END(tracer, frames) (tracer)->end (frames)
+
+#else
+
+#define TRACE_BEGIN(tracer)
+#define TRACE_LAP(tracer, stage)
+#define TRACE_END(tracer, frames)
+
+#endif /* BANGR_TRACE */
+
+#endif /* TRACE_HPP_ */
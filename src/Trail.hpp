@@ -0,0 +1,192 @@
+/* B.Angr
+ * Glitch effect sequencer LV2 plugin
+ *
+ * Copyright (C) 2021 - 2022 by Sven Jähnichen
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRAIL_HPP_
+#define TRAIL_HPP_
+
+#include "BWidgets/BStyles/Types/Color.hpp"
+#include "BWidgets/BWidgets/Widget.hpp"
+#include "LayerCache.hpp"
+#include "CursorMessage.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+
+#ifndef BANGR_TRAIL_HISTORY
+#define BANGR_TRAIL_HISTORY 150
+#endif
+
+#define BANGR_TRAIL_BANDS 6
+#define BANGR_TRAIL_MARGIN 4.0
+
+/**
+Fading trajectory of the cursor. Keeps the last BANGR_TRAIL_HISTORY packed
+cursor positions (see packTrailPoint()) and draws them as a polyline from
+transparent (oldest) to opaque (newest). The cursor range is inset by
+BANGR_TRAIL_MARGIN to not clip the line at the borders. The polyline is cached and only
+rebuilt if points were added, not on each repaint by cursor moves.
+ */
+class Trail : public BWidgets::Widget
+{
+public:
+	Trail () : Trail (0, 0, 0, 0, BUTILITIES_URID_UNKNOWN_URID, "") {}
+	Trail (uint32_t urid = BUTILITIES_URID_UNKNOWN_URID, std::string title = "") :
+			Trail (0, 0, 0, 0, urid, title) {}
+	Trail (const double x, const double y, const double width, const double height, 
+			uint32_t urid = BUTILITIES_URID_UNKNOWN_URID, std::string title = "") :
+			Widget (x, y, width, height, urid, title),
+			points_ {0},
+			head_ (0),
+			count_ (0),
+			revision_ (0)
+	{}
+
+	virtual Widget* clone () const override 
+	{
+		Widget* f = new Trail (urid_, title_);
+		f->copy (this);
+		return f;
+	}
+
+	inline void copy (const Trail* that)
+	{
+		points_ = that->points_;
+		head_ = that->head_;
+		count_ = that->count_;
+		++revision_;
+		Widget::copy (that);
+	}
+
+	/**
+	Appends a batch of cursor positions. Call update() once after all
+	batches of a frame are added.
+	@param points	Packed cursor positions, oldest first.
+	@param n	Number of points.
+	 */
+	void addPoints (const uint32_t* points, const uint32_t n)
+	{
+		if (n == 0) return;
+		const uint32_t first = (n > BANGR_TRAIL_HISTORY ? n - BANGR_TRAIL_HISTORY : 0);
+		for (uint32_t i = first; i < n; ++i)
+		{
+			points_[head_] = points[i];
+			head_ = (head_ + 1) % BANGR_TRAIL_HISTORY;
+		}
+		count_ = std::min<size_t> (count_ + (n - first), BANGR_TRAIL_HISTORY);
+		++revision_;
+	}
+
+	void clear ()
+	{
+		if (count_ == 0) return;
+		count_ = 0;
+		++revision_;
+		update ();
+	}
+
+	size_t size () const {return count_;}
+
+protected:
+	std::array<uint32_t, BANGR_TRAIL_HISTORY> points_;
+	size_t head_;
+	size_t count_;
+	uint64_t revision_;
+	LayerCache layer_;
+
+	virtual void draw (const BUtilities::Area<>& area) override
+	{
+		if ((!cairoSurface()) || (cairo_surface_status (cairoSurface()) != CAIRO_STATUS_SUCCESS)) return;
+
+		// Draw super class widget elements first
+		Widget::draw (area);
+
+		const double x0 = getXOffset ();
+		const double y0 = getYOffset ();
+		const double h = getEffectiveHeight ();
+		const double w = getEffectiveWidth ();
+
+		if ((w > 0) && (h > 0))
+		{
+			cairoplus_surface_clear (cairoSurface());
+			if (count_ < 2) return;
+
+			cairo_t* cr = cairo_create (cairoSurface());
+
+			if (cairo_status (cr) == CAIRO_STATUS_SUCCESS)
+			{
+				// Limit cairo-drawing area
+				cairo_rectangle (cr, area.getX (), area.getY (), area.getWidth (), area.getHeight ());
+				cairo_clip (cr);
+
+				const BStyles::Color fg = getFgColors()[getStatus()];
+
+				// Polyline from cache, (re-)draw on new points, zoom, resize or style changes
+				const double scale = LayerCache::getScale (cairoSurface());
+				const uint64_t key = LayerCache::makeKey ({double (revision_), x0, y0, w, h, fg.red, fg.green, fg.blue, fg.alpha});
+				if (!layer_.isValid (getWidth(), getHeight(), scale, key))
+				{
+					cairo_t* lcr = layer_.create (getWidth(), getHeight(), scale, key);
+					if (lcr)
+					{
+						drawTrail (lcr, x0, y0, w, h, fg);
+						cairo_destroy (lcr);
+					}
+				}
+
+				if (layer_.isValid (getWidth(), getHeight(), scale, key)) layer_.paint (cr);
+				else drawTrail (cr, x0, y0, w, h, fg);
+			}
+			cairo_destroy (cr);
+		}
+	}
+
+	void drawTrail (cairo_t* cr, const double x0, const double y0, const double w, const double h, BStyles::Color fg) const
+	{
+		// Fade in bands of connected points, one stroke per band instead
+		// of one per segment
+		const size_t tail = (head_ + BANGR_TRAIL_HISTORY - count_) % BANGR_TRAIL_HISTORY;
+		const double alpha = fg.alpha;
+		cairo_set_line_width (cr, 1.5);
+		cairo_set_line_cap (cr, CAIRO_LINE_CAP_ROUND);
+		cairo_set_line_join (cr, CAIRO_LINE_JOIN_ROUND);
+
+		for (int b = 0; b < BANGR_TRAIL_BANDS; ++b)
+		{
+			const size_t start = b * (count_ - 1) / BANGR_TRAIL_BANDS;
+			const size_t end = (b + 1) * (count_ - 1) / BANGR_TRAIL_BANDS;
+			if (end <= start) continue;
+
+			for (size_t i = start; i <= end; ++i)
+			{
+				const uint32_t p = points_[(tail + i) % BANGR_TRAIL_HISTORY];
+				const double x = x0 + BANGR_TRAIL_MARGIN + unpackTrailX (p) * (w - 2.0 * BANGR_TRAIL_MARGIN);
+				const double y = y0 + BANGR_TRAIL_MARGIN + unpackTrailY (p) * (h - 2.0 * BANGR_TRAIL_MARGIN);
+				if (i == start) cairo_move_to (cr, x, y);
+				else cairo_line_to (cr, x, y);
+			}
+
+			fg.alpha = alpha * double (b + 1) / BANGR_TRAIL_BANDS;
+			cairo_set_source_rgba (cr, CAIRO_RGBA (fg));
+			cairo_stroke (cr);
+		}
+	}
+};
+
+#endif /* TRAIL_HPP_ */
@@ -31,6 +31,11 @@ struct BAngrURIs
 {
 	LV2_URID atom_URID;
 	LV2_URID atom_Float;
+	LV2_URID atom_Int;
+	LV2_URID atom_Vector;
+	LV2_URID atom_Long;
+	LV2_URID atom_Chunk;
+	LV2_URID atom_Bool;
 	LV2_URID atom_Object;
 	LV2_URID atom_Blank;
 	LV2_URID atom_eventTransfer;
@@ -41,12 +46,28 @@ struct BAngrURIs
 	LV2_URID bangr_cursorOff;
 	LV2_URID bangr_xcursor;
 	LV2_URID bangr_ycursor;
+	LV2_URID bangr_xvelocity;
+	LV2_URID bangr_yvelocity;
+	LV2_URID bangr_cursor;
+	LV2_URID bangr_listen;
+	LV2_URID bangr_notifyRate;
+	LV2_URID bangr_uiOn;
+	LV2_URID bangr_uiOff;
+	LV2_URID bangr_checkpoint;
+	LV2_URID bangr_trail;
+	LV2_URID bangr_trailPoints;
+	LV2_URID bangr_seed;
 };
 
 inline void getURIs (LV2_URID_Map* m, BAngrURIs* uris)
 {
 	uris->atom_URID = m->map(m->handle, LV2_ATOM__URID);
 	uris->atom_Float = m->map(m->handle, LV2_ATOM__Float);
+	uris->atom_Int = m->map(m->handle, LV2_ATOM__Int);
+	uris->atom_Vector = m->map(m->handle, LV2_ATOM__Vector);
+	uris->atom_Long = m->map(m->handle, LV2_ATOM__Long);
+	uris->atom_Chunk = m->map(m->handle, LV2_ATOM__Chunk);
+	uris->atom_Bool = m->map(m->handle, LV2_ATOM__Bool);
 	uris->atom_Object = m->map(m->handle, LV2_ATOM__Object);
 	uris->atom_Blank = m->map(m->handle, LV2_ATOM__Blank);
 	uris->atom_eventTransfer = m->map(m->handle, LV2_ATOM__eventTransfer);
@@ -57,6 +78,17 @@ inline void getURIs (LV2_URID_Map* m, BAngrURIs* uris)
 	uris->bangr_cursorOff = m->map(m->handle, BANGR_URI "#cursorOff");
 	uris->bangr_xcursor = m->map(m->handle, BANGR_URI "#xcursor");
 	uris->bangr_ycursor = m->map(m->handle, BANGR_URI "#ycursor");
+	uris->bangr_xvelocity = m->map(m->handle, BANGR_URI "#xvelocity");
+	uris->bangr_yvelocity = m->map(m->handle, BANGR_URI "#yvelocity");
+	uris->bangr_cursor = m->map(m->handle, BANGR_URI "#cursor");
+	uris->bangr_listen = m->map(m->handle, BANGR_URI "#listen");
+	uris->bangr_notifyRate = m->map(m->handle, BANGR_URI "#notifyRate");
+	uris->bangr_uiOn = m->map(m->handle, BANGR_URI "#uiOn");
+	uris->bangr_uiOff = m->map(m->handle, BANGR_URI "#uiOff");
+	uris->bangr_checkpoint = m->map(m->handle, BANGR_URI "#checkpoint");
+	uris->bangr_trail = m->map(m->handle, BANGR_URI "#trail");
+	uris->bangr_trailPoints = m->map(m->handle, BANGR_URI "#trailPoints");
+	uris->bangr_seed = m->map(m->handle, BANGR_URI "#seed");
 }
 
 #endif /* URIDS_HPP_ */
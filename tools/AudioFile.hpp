@@ -0,0 +1,436 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef AUDIOFILE_HPP_
+#define AUDIOFILE_HPP_
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+PCM sample formats (little endian, interleaved).
+ */
+enum SampleFormat
+{
+	SAMPLE_INT16	= 0,
+	SAMPLE_INT24	= 1,
+	SAMPLE_INT32	= 2,
+	SAMPLE_FLOAT32	= 3,
+	NR_SAMPLE_FORMATS	= 4
+};
+
+const char* const sampleFormatNames[NR_SAMPLE_FORMATS] = {"s16", "s24", "s32", "f32"};
+const uint32_t sampleFormatSizes[NR_SAMPLE_FORMATS] = {2, 3, 4, 4};
+
+/**
+Parses a sample format name (s16, s24, s32, f32).
+@param name	Format name.
+@param format	Target format.
+@return		True on success.
+ */
+inline bool parseSampleFormat (const char* name, SampleFormat& format)
+{
+	for (int i = 0; i < NR_SAMPLE_FORMATS; ++i)
+	{
+		if (strcmp (name, sampleFormatNames[i]) == 0)
+		{
+			format = SampleFormat (i);
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+Converts interleaved PCM frames to a (non-interleaved) stereo pair. Mono
+input is copied to both channels.
+@param format	Sample format.
+@param channels	Number of interleaved channels (1 or 2).
+@param data	Interleaved PCM data.
+@param left	Target left channel.
+@param right	Target right channel.
+@param frames	Number of frames.
+ */
+inline void decodeSamples (const SampleFormat format, const uint32_t channels, const uint8_t* data, float* left, float* right, const uint32_t frames)
+{
+	const uint32_t size = sampleFormatSizes[format];
+	for (uint32_t i = 0; i < frames; ++i)
+	{
+		for (uint32_t c = 0; c < channels; ++c)
+		{
+			const uint8_t* p = data + (i * channels + c) * size;
+			float value;
+			switch (format)
+			{
+				case SAMPLE_INT16:
+					value = int16_t (p[0] | (p[1] << 8)) / 32768.0f;
+					break;
+				case SAMPLE_INT24:
+					value = (int32_t (uint32_t (p[0] << 8) | uint32_t (p[1] << 16) | uint32_t (p[2] << 24)) >> 8) / 8388608.0f;
+					break;
+				case SAMPLE_INT32:
+					value = int32_t (uint32_t (p[0]) | uint32_t (p[1] << 8) | uint32_t (p[2] << 16) | uint32_t (p[3]) << 24) / 2147483648.0f;
+					break;
+				default:
+					memcpy (&value, p, sizeof (float));
+			}
+			if (c == 0) left[i] = value;
+			else right[i] = value;
+		}
+		if (channels == 1) right[i] = left[i];
+	}
+}
+
+/**
+Converts a stereo pair to interleaved stereo PCM frames. Integer formats
+are clipped.
+@param format	Sample format.
+@param left	Left channel.
+@param right	Right channel.
+@param data	Target PCM buffer (frames * 2 * sample size bytes).
+@param frames	Number of frames.
+ */
+inline void encodeSamples (const SampleFormat format, const float* left, const float* right, uint8_t* data, const uint32_t frames)
+{
+	const uint32_t size = sampleFormatSizes[format];
+	for (uint32_t i = 0; i < 2 * frames; ++i)
+	{
+		const float value = ((i & 1) ? right[i >> 1] : left[i >> 1]);
+		const float clipped = (value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value));
+		uint8_t* p = data + i * size;
+		switch (format)
+		{
+			case SAMPLE_INT16:
+			{
+				const int32_t v = (clipped >= 1.0f ? 32767 : int32_t (lrintf (clipped * 32768.0f)));
+				p[0] = v; p[1] = v >> 8;
+				break;
+			}
+			case SAMPLE_INT24:
+			{
+				const int32_t v = (clipped >= 1.0f ? 8388607 : int32_t (lrintf (clipped * 8388608.0f)));
+				p[0] = v; p[1] = v >> 8; p[2] = v >> 16;
+				break;
+			}
+			case SAMPLE_INT32:
+			{
+				const int32_t v = (clipped >= 1.0f ? 2147483647 : int32_t (lrint (clipped * 2147483648.0)));
+				p[0] = v; p[1] = v >> 8; p[2] = v >> 16; p[3] = v >> 24;
+				break;
+			}
+			default:
+				memcpy (p, &value, sizeof (float));
+		}
+	}
+}
+
+/**
+Read-only memory-mapped PCM input file. Supports WAV (PCM 16, 24, 32 bit
+integer and 32 bit float, including WAVE_FORMAT_EXTENSIBLE) and headerless
+raw PCM with a provided format.
+ */
+class AudioFileReader
+{
+public:
+	AudioFileReader () :
+		rate (0),
+		channels (0),
+		format (SAMPLE_FLOAT32),
+		frames (0),
+		map_ (nullptr),
+		mapSize_ (0),
+		data_ (nullptr)
+	{}
+
+	AudioFileReader (const AudioFileReader& that) = delete;
+	AudioFileReader& operator= (const AudioFileReader& that) = delete;
+
+	~AudioFileReader () {close ();}
+
+	/**
+	Maps a WAV file.
+	@param filename	File name.
+	@param error	Error message on failure.
+	@return		True on success.
+	 */
+	bool openWav (const std::string& filename, std::string& error)
+	{
+		if (!map (filename, error)) return false;
+		const uint8_t* p = static_cast<const uint8_t*> (map_);
+		if ((mapSize_ < 12) || (memcmp (p, "RIFF", 4) != 0) || (memcmp (p + 8, "WAVE", 4) != 0))
+		{
+			error = "Not a RIFF/WAVE file";
+			close ();
+			return false;
+		}
+
+		bool fmtFound = false;
+		size_t pos = 12;
+		while (pos + 8 <= mapSize_)
+		{
+			const uint32_t chunkSize = read32 (p + pos + 4);
+			const uint8_t* chunk = p + pos + 8;
+			const size_t available = mapSize_ - (pos + 8);
+
+			if ((memcmp (p + pos, "fmt ", 4) == 0) && (chunkSize >= 16) && (available >= 16))
+			{
+				uint16_t tag = read16 (chunk);
+				if ((tag == 0xFFFE) && (chunkSize >= 26) && (available >= 26)) tag = read16 (chunk + 24);
+				channels = read16 (chunk + 2);
+				rate = read32 (chunk + 4);
+				const uint16_t bits = read16 (chunk + 14);
+
+				if ((tag == 3) && (bits == 32)) format = SAMPLE_FLOAT32;
+				else if ((tag == 1) && (bits == 16)) format = SAMPLE_INT16;
+				else if ((tag == 1) && (bits == 24)) format = SAMPLE_INT24;
+				else if ((tag == 1) && (bits == 32)) format = SAMPLE_INT32;
+				else
+				{
+					error = "Unsupported WAV sample format";
+					close ();
+					return false;
+				}
+				fmtFound = true;
+			}
+
+			else if ((memcmp (p + pos, "data", 4) == 0) && fmtFound)
+			{
+				const size_t size = (chunkSize < available ? chunkSize : available);
+				return setData (chunk, size, error);
+			}
+
+			pos += 8 + size_t (chunkSize) + (chunkSize & 1);
+		}
+
+		error = (fmtFound ? "No data chunk" : "No fmt chunk");
+		close ();
+		return false;
+	}
+
+	/**
+	Maps a headerless raw PCM file.
+	@param filename	File name.
+	@param rate	Sample rate.
+	@param channels	Number of interleaved channels.
+	@param format	Sample format.
+	@param error	Error message on failure.
+	@return		True on success.
+	 */
+	bool openRaw (const std::string& filename, const uint32_t rate, const uint32_t channels, const SampleFormat format, std::string& error)
+	{
+		if (!map (filename, error)) return false;
+		this->rate = rate;
+		this->channels = channels;
+		this->format = format;
+		return setData (static_cast<const uint8_t*> (map_), mapSize_, error);
+	}
+
+	void close ()
+	{
+		if (map_) munmap (map_, mapSize_);
+		map_ = nullptr;
+		mapSize_ = 0;
+		data_ = nullptr;
+		frames = 0;
+	}
+
+	/**
+	Converts frames to a stereo pair.
+	@param start	First frame.
+	@param left	Target left channel.
+	@param right	Target right channel.
+	@param n	Number of frames.
+	 */
+	void read (const uint64_t start, float* left, float* right, const uint32_t n) const
+	{
+		decodeSamples (format, channels, data_ + start * channels * sampleFormatSizes[format], left, right, n);
+	}
+
+	uint32_t rate;
+	uint32_t channels;
+	SampleFormat format;
+	uint64_t frames;
+
+private:
+	void* map_;
+	size_t mapSize_;
+	const uint8_t* data_;
+
+	static uint16_t read16 (const uint8_t* p) {return p[0] | (p[1] << 8);}
+	static uint32_t read32 (const uint8_t* p) {return uint32_t (p[0]) | (uint32_t (p[1]) << 8) | (uint32_t (p[2]) << 16) | (uint32_t (p[3]) << 24);}
+
+	bool map (const std::string& filename, std::string& error)
+	{
+		close ();
+		const int fd = ::open (filename.c_str(), O_RDONLY);
+		if (fd < 0)
+		{
+			error = "Can't open file";
+			return false;
+		}
+
+		struct stat st;
+		if ((fstat (fd, &st) != 0) || (st.st_size <= 0))
+		{
+			::close (fd);
+			error = "Empty file";
+			return false;
+		}
+
+		void* ptr = mmap (nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		::close (fd);
+		if (ptr == MAP_FAILED)
+		{
+			error = "Can't map file";
+			return false;
+		}
+
+		madvise (ptr, st.st_size, MADV_SEQUENTIAL);
+		map_ = ptr;
+		mapSize_ = st.st_size;
+		return true;
+	}
+
+	bool setData (const uint8_t* data, const size_t size, std::string& error)
+	{
+		if ((channels < 1) || (channels > 2) || (rate == 0))
+		{
+			error = "Only mono and stereo files with a valid sample rate are supported";
+			close ();
+			return false;
+		}
+		data_ = data;
+		frames = size / (channels * sampleFormatSizes[format]);
+		return true;
+	}
+};
+
+/**
+Stereo PCM output file. Writes a WAV file (header is completed on close)
+or headerless raw PCM.
+ */
+class AudioFileWriter
+{
+public:
+	AudioFileWriter () :
+		file_ (nullptr),
+		wav_ (false),
+		format_ (SAMPLE_FLOAT32),
+		rate_ (0),
+		frames_ (0)
+	{}
+
+	AudioFileWriter (const AudioFileWriter& that) = delete;
+	AudioFileWriter& operator= (const AudioFileWriter& that) = delete;
+
+	~AudioFileWriter () {close ();}
+
+	/**
+	Creates an output file.
+	@param filename	File name.
+	@param wav	True for WAV, false for raw PCM.
+	@param rate	Sample rate.
+	@param format	Sample format.
+	@return		True on success.
+	 */
+	bool open (const std::string& filename, const bool wav, const uint32_t rate, const SampleFormat format)
+	{
+		close ();
+		file_ = fopen (filename.c_str(), "wb");
+		if (!file_) return false;
+		wav_ = wav;
+		format_ = format;
+		rate_ = rate;
+		frames_ = 0;
+		if (wav_) writeHeader ();
+		return !ferror (file_);
+	}
+
+	/**
+	Writes PCM data.
+	@param data	Interleaved stereo PCM data in the file format.
+	@param n	Number of frames.
+	@return		True on success.
+	 */
+	bool write (const uint8_t* data, const uint32_t n)
+	{
+		if (!file_) return false;
+		const size_t size = size_t (n) * 2 * sampleFormatSizes[format_];
+		frames_ += n;
+		return (fwrite (data, 1, size, file_) == size);
+	}
+
+	/**
+	Completes and closes the file.
+	@return		True on success.
+	 */
+	bool close ()
+	{
+		if (!file_) return true;
+		bool ok = true;
+		if (wav_)
+		{
+			ok = (fseek (file_, 0, SEEK_SET) == 0);
+			if (ok) writeHeader ();
+		}
+		ok = (!ferror (file_)) && ok;
+		ok = (fclose (file_) == 0) && ok;
+		file_ = nullptr;
+		return ok;
+	}
+
+private:
+	FILE* file_;
+	bool wav_;
+	SampleFormat format_;
+	uint32_t rate_;
+	uint64_t frames_;
+
+	void put16 (const uint16_t v) {const uint8_t b[2] = {uint8_t (v), uint8_t (v >> 8)}; fwrite (b, 1, 2, file_);}
+	void put32 (const uint32_t v) {const uint8_t b[4] = {uint8_t (v), uint8_t (v >> 8), uint8_t (v >> 16), uint8_t (v >> 24)}; fwrite (b, 1, 4, file_);}
+
+	void writeHeader ()
+	{
+		const uint32_t size = sampleFormatSizes[format_];
+		const uint64_t dataSize = frames_ * 2 * size;
+		const uint32_t dataSize32 = (dataSize > 0xFFFFFFFFULL - 36 ? 0xFFFFFFFFUL - 36 : dataSize);
+		fwrite ("RIFF", 1, 4, file_);
+		put32 (36 + dataSize32);
+		fwrite ("WAVEfmt ", 1, 8, file_);
+		put32 (16);
+		put16 (format_ == SAMPLE_FLOAT32 ? 3 : 1);
+		put16 (2);
+		put32 (rate_);
+		put32 (rate_ * 2 * size);
+		put16 (2 * size);
+		put16 (8 * size);
+		fwrite ("data", 1, 4, file_);
+		put32 (dataSize32);
+	}
+};
+
+#endif /* AUDIOFILE_HPP_ */
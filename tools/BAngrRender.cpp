@@ -0,0 +1,527 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Offline renderer. Processes WAV or raw PCM files through the B.Angr
+ * engine without an LV2 host. Input files are memory-mapped and processed in
+ * parallel by a pool of worker threads, each file with its own engine
+ * instance.
+ *
+ * In stream mode, raw PCM is filtered from stdin to stdout. A reader, a
+ * DSP and a writer thread pass the blocks through preallocated double
+ * buffers, thus memory use is constant.
+ *
+ * Usage: bangr-render [OPTIONS] FILE...
+ *        bangr-render --stream [OPTIONS] < INPUT > OUTPUT
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <csignal>
+#include <poll.h>
+#include <unistd.h>
+#include "AudioFile.hpp"
+#include "BlockPipe.hpp"
+#include "Preset.hpp"
+#include "BAngrEngine.hpp"
+#include "Ports.hpp"
+
+struct RenderSettings
+{
+	Preset preset;
+	bool seeded = false;
+	uint64_t seed = 0;
+	uint32_t blockSize = 1024;
+	std::string outDir;
+	std::string suffix = ".bangr";
+	bool raw = false;
+	uint32_t rawRate = 48000;
+	uint32_t rawChannels = 2;
+	SampleFormat rawFormat = SAMPLE_FLOAT32;
+	SampleFormat outFormat = SAMPLE_FLOAT32;
+	bool quiet = false;
+	bool stream = false;
+	double reportInterval = 0.0;
+};
+
+struct RenderResult
+{
+	bool ok = false;
+	std::string output;
+	std::string error;
+	uint64_t frames = 0;
+	double seconds = 0.0;
+	double audioSeconds = 0.0;
+};
+
+static std::string outputName (const std::string& input, const RenderSettings& settings)
+{
+	const size_t slash = input.rfind ('/');
+	const size_t dot = input.rfind ('.');
+	const bool hasExt = (dot != std::string::npos) && ((slash == std::string::npos) || (dot > slash));
+	const std::string stem = (hasExt ? input.substr (0, dot) : input);
+	const std::string ext = (hasExt ? input.substr (dot) : std::string (settings.raw ? ".raw" : ".wav"));
+	if (settings.outDir.empty()) return stem + settings.suffix + ext;
+	const std::string base = (slash == std::string::npos ? stem : stem.substr (slash + 1));
+	return settings.outDir + "/" + base + settings.suffix + ext;
+}
+
+static void setupEngine (BAngrEngine& engine, const RenderSettings& settings)
+{
+	for (int i = 0; i < NR_CONTROLLERS; ++i) engine.setController (i, settings.preset.controllers[i]);
+	if (settings.seeded) engine.seed (settings.seed);
+	if (settings.preset.hasXCursor) engine.setXCursor (settings.preset.xcursor);
+	if (settings.preset.hasYCursor) engine.setYCursor (settings.preset.ycursor);
+}
+
+static RenderResult render (const std::string& input, const RenderSettings& settings)
+{
+	RenderResult result;
+	result.output = outputName (input, settings);
+
+	AudioFileReader reader;
+	const bool opened =
+	(
+		settings.raw ?
+		reader.openRaw (input, settings.rawRate, settings.rawChannels, settings.rawFormat, result.error) :
+		reader.openWav (input, result.error)
+	);
+	if (!opened) return result;
+
+	AudioFileWriter writer;
+	if (!writer.open (result.output, !settings.raw, reader.rate, settings.outFormat))
+	{
+		result.error = "Can't create " + result.output;
+		return result;
+	}
+
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+	// Own engine instance
+	BAngrEngine engine (reader.rate, settings.blockSize);
+	setupEngine (engine, settings);
+
+	const uint32_t block = settings.blockSize;
+	std::vector<float> in1 (block);
+	std::vector<float> in2 (block);
+	std::vector<float> out1 (block);
+	std::vector<float> out2 (block);
+	std::vector<uint8_t> pcm (size_t (block) * 2 * sampleFormatSizes[settings.outFormat]);
+
+	for (uint64_t pos = 0; pos < reader.frames; pos += block)
+	{
+		const uint32_t n = std::min<uint64_t> (block, reader.frames - pos);
+		reader.read (pos, in1.data(), in2.data(), n);
+		engine.process (in1.data(), in2.data(), out1.data(), out2.data(), n);
+		encodeSamples (settings.outFormat, out1.data(), out2.data(), pcm.data(), n);
+		if (!writer.write (pcm.data(), n))
+		{
+			result.error = "Can't write " + result.output;
+			return result;
+		}
+	}
+
+	if (!writer.close())
+	{
+		result.error = "Can't write " + result.output;
+		return result;
+	}
+
+	result.ok = true;
+	result.frames = reader.frames;
+	result.audioSeconds = double (reader.frames) / reader.rate;
+	result.seconds = std::chrono::duration<double> (std::chrono::steady_clock::now() - t0).count();
+	return result;
+}
+
+#define LATENCY_BINS 32
+
+/**
+Constant memory statistics of the block latency (time from a block being
+read until it is written) with log2 microsecond bins.
+ */
+struct LatencyStats
+{
+	uint64_t count = 0;
+	double sum = 0.0;
+	double max = 0.0;
+	uint64_t bins[LATENCY_BINS] = {0};
+
+	void add (const double seconds)
+	{
+		const double us = seconds * 1e6;
+		++count;
+		sum += seconds;
+		max = std::max (max, seconds);
+		++bins[(us < 1.0 ? 0 : std::min<int> (LATENCY_BINS - 1, 1 + int (log2 (us))))];
+	}
+
+	// Upper bound of the bin containing the percentile
+	double percentile (const double p) const
+	{
+		uint64_t n = 0;
+		for (int b = 0; b < LATENCY_BINS; ++b)
+		{
+			n += bins[b];
+			if (n >= p * count) return std::min (pow (2.0, b) * 1e-6, max);
+		}
+		return max;
+	}
+
+	void print (const char* title) const
+	{
+		if (count == 0) return;
+		fprintf
+		(
+			stderr,
+			"%s: %lu blocks, latency mean %.3f ms, p50 <= %.3f ms, p99 <= %.3f ms, max %.3f ms\n",
+			title, (unsigned long) count, 1e3 * sum / count, 1e3 * percentile (0.5), 1e3 * percentile (0.99), 1e3 * max
+		);
+	}
+};
+
+static bool readFully (const int fd, uint8_t* data, const size_t size, size_t& done, const std::atomic<bool>& stop)
+{
+	done = 0;
+	while ((done < size) && (!stop))
+	{
+		// Wait with timeout, thus the reader can be stopped if the output fails
+		pollfd p = {fd, POLLIN, 0};
+		const int r = poll (&p, 1, 100);
+		if ((r < 0) && (errno == EINTR)) continue;
+		if (r < 0) return false;
+		if (r == 0) continue;
+
+		const ssize_t n = read (fd, data + done, size - done);
+		if (n == 0) return true;
+		if ((n < 0) && (errno == EINTR)) continue;
+		if (n < 0) return false;
+		done += n;
+	}
+	return true;
+}
+
+static bool writeFully (const int fd, const uint8_t* data, const size_t size)
+{
+	size_t done = 0;
+	while (done < size)
+	{
+		const ssize_t n = write (fd, data + done, size - done);
+		if ((n < 0) && (errno == EINTR)) continue;
+		if (n <= 0) return false;
+		done += n;
+	}
+	return true;
+}
+
+static int stream (const RenderSettings& settings)
+{
+	const uint32_t block = settings.blockSize;
+	const uint32_t inFrameSize = settings.rawChannels * sampleFormatSizes[settings.rawFormat];
+	const uint32_t outFrameSize = 2 * sampleFormatSizes[settings.outFormat];
+	BlockPipe<2> inPipe (size_t (block) * inFrameSize);
+	BlockPipe<2> outPipe (size_t (block) * outFrameSize);
+	std::atomic<bool> failed (false);
+	std::atomic<bool> stop (false);
+
+	BAngrEngine engine (settings.rawRate, block);
+	setupEngine (engine, settings);
+
+	signal (SIGPIPE, SIG_IGN);
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	uint64_t frames = 0;
+	LatencyStats latency;
+
+	std::thread reader
+	(
+		[&] ()
+		{
+			while (StreamBlock* b = inPipe.beginPush())
+			{
+				size_t bytes;
+				const bool ok = readFully (STDIN_FILENO, b->pcm.data(), b->pcm.size(), bytes, stop);
+				if (stop) break;
+				if (!ok)
+				{
+					fprintf (stderr, "Can't read from stdin.\n");
+					failed = true;
+					stop = true;
+					inPipe.abort();
+					outPipe.abort();
+					break;
+				}
+
+				if (bytes % inFrameSize)
+				{
+					fprintf (stderr, "Input ends with an incomplete frame, %lu bytes dropped.\n", (unsigned long) (bytes % inFrameSize));
+				}
+				b->frames = bytes / inFrameSize;
+				b->last = (bytes < b->pcm.size());
+				b->time = std::chrono::steady_clock::now();
+				inPipe.endPush();
+				if (b->last) break;
+			}
+		}
+	);
+
+	std::thread dsp
+	(
+		[&] ()
+		{
+			std::vector<float> in1 (block);
+			std::vector<float> in2 (block);
+			std::vector<float> out1 (block);
+			std::vector<float> out2 (block);
+
+			while (StreamBlock* in = inPipe.beginPop())
+			{
+				StreamBlock* out = outPipe.beginPush();
+				if (!out) break;
+
+				if (in->frames)
+				{
+					decodeSamples (settings.rawFormat, settings.rawChannels, in->pcm.data(), in1.data(), in2.data(), in->frames);
+					engine.process (in1.data(), in2.data(), out1.data(), out2.data(), in->frames);
+					encodeSamples (settings.outFormat, out1.data(), out2.data(), out->pcm.data(), in->frames);
+				}
+				out->frames = in->frames;
+				out->last = in->last;
+				out->time = in->time;
+				const bool last = in->last;
+				inPipe.endPop();
+				outPipe.endPush();
+				if (last) break;
+			}
+		}
+	);
+
+	std::thread writer
+	(
+		[&] ()
+		{
+			std::chrono::steady_clock::time_point lastReport = t0;
+			LatencyStats interval;
+
+			while (StreamBlock* b = outPipe.beginPop())
+			{
+				if (!writeFully (STDOUT_FILENO, b->pcm.data(), size_t (b->frames) * outFrameSize))
+				{
+					// Closed output (e.g., piped to head) ends the stream,
+					// but isn't an error
+					if (errno != EPIPE)
+					{
+						fprintf (stderr, "Can't write to stdout.\n");
+						failed = true;
+					}
+					stop = true;
+					inPipe.abort();
+					outPipe.abort();
+					break;
+				}
+
+				const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+				const double dt = std::chrono::duration<double> (now - b->time).count();
+				frames += b->frames;
+				latency.add (dt);
+				interval.add (dt);
+
+				if ((settings.reportInterval > 0.0) && (std::chrono::duration<double> (now - lastReport).count() >= settings.reportInterval))
+				{
+					interval.print ("Interval");
+					interval = LatencyStats();
+					lastReport = now;
+				}
+
+				const bool last = b->last;
+				outPipe.endPop();
+				if (last) break;
+			}
+		}
+	);
+
+	writer.join();
+	dsp.join();
+	reader.join();
+
+	if (!settings.quiet)
+	{
+		const double seconds = std::chrono::duration<double> (std::chrono::steady_clock::now() - t0).count();
+		fprintf
+		(
+			stderr,
+			"Stream: %lu frames (%.1f s audio) in %.2f s, block %u frames (%.3f ms), buffering up to %u frames (%.3f ms)\n",
+			(unsigned long) frames, double (frames) / settings.rawRate, seconds,
+			block, 1e3 * block / settings.rawRate, 4 * block, 4e3 * block / settings.rawRate
+		);
+		latency.print ("Total");
+	}
+
+	return (failed ? 1 : 0);
+}
+
+static void printUsage ()
+{
+	fprintf
+	(
+		stderr,
+		"Usage: bangr-render [OPTIONS] FILE...\n"
+		"       bangr-render --stream [OPTIONS] < INPUT > OUTPUT\n"
+		"  --preset FILE       Controller values from an LV2 preset (TTL) or JSON\n"
+		"  --set SYMBOL=VALUE  Set a single controller (port symbol)\n"
+		"  --x X, --y Y        Initial cursor position [0, 1]\n"
+		"  --seed N            Seed for reproducible output\n"
+		"  --jobs N            Number of worker threads (default: number of CPUs)\n"
+		"  --block N           Block size in frames (default 1024)\n"
+		"  --out-dir DIR       Output directory (default: next to the input)\n"
+		"  --suffix S          Output file name suffix (default .bangr)\n"
+		"  --out-format FMT    Output sample format s16, s24, s32, f32 (default f32)\n"
+		"  --raw               Input files are headerless raw PCM\n"
+		"  --rate HZ           Raw input sample rate (default 48000)\n"
+		"  --channels N        Raw input channels, 1 or 2 (default 2)\n"
+		"  --format FMT        Raw input sample format (default f32)\n"
+		"  --stream            Filter raw PCM from stdin to stdout (uses the raw input options)\n"
+		"  --report S          Report the stream latency every S seconds\n"
+		"  --quiet             Only report errors\n"
+		"  --help              Show this help\n"
+	);
+}
+
+int main (int argc, char** argv)
+{
+	RenderSettings settings;
+	std::vector<std::string> files;
+	std::vector<std::pair<int, float>> sets;
+	Preset cursor;
+	const char* presetFile = nullptr;
+	unsigned int jobs = std::max (1u, std::thread::hardware_concurrency());
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const bool hasArg = (i + 1 < argc);
+		if ((strcmp (argv[i], "--preset") == 0) && hasArg) presetFile = argv[++i];
+		else if ((strcmp (argv[i], "--set") == 0) && hasArg)
+		{
+			const char* arg = argv[++i];
+			const char* eq = strchr (arg, '=');
+			const int index = (eq ? findControllerSymbol (arg, eq - arg) : -1);
+			if (index < 0)
+			{
+				fprintf (stderr, "Unknown controller in --set %s.\n", arg);
+				return 1;
+			}
+			sets.push_back (std::make_pair (index, float (atof (eq + 1))));
+		}
+		else if ((strcmp (argv[i], "--x") == 0) && hasArg) cursor.setXCursor (atof (argv[++i]));
+		else if ((strcmp (argv[i], "--y") == 0) && hasArg) cursor.setYCursor (atof (argv[++i]));
+		else if ((strcmp (argv[i], "--seed") == 0) && hasArg)
+		{
+			settings.seeded = true;
+			settings.seed = strtoull (argv[++i], nullptr, 0);
+		}
+		else if ((strcmp (argv[i], "--jobs") == 0) && hasArg) jobs = atoi (argv[++i]);
+		else if ((strcmp (argv[i], "--block") == 0) && hasArg) settings.blockSize = atoi (argv[++i]);
+		else if ((strcmp (argv[i], "--out-dir") == 0) && hasArg) settings.outDir = argv[++i];
+		else if ((strcmp (argv[i], "--suffix") == 0) && hasArg) settings.suffix = argv[++i];
+		else if ((strcmp (argv[i], "--out-format") == 0) && hasArg && parseSampleFormat (argv[i + 1], settings.outFormat)) ++i;
+		else if (strcmp (argv[i], "--raw") == 0) settings.raw = true;
+		else if ((strcmp (argv[i], "--rate") == 0) && hasArg) settings.rawRate = atoi (argv[++i]);
+		else if ((strcmp (argv[i], "--channels") == 0) && hasArg) settings.rawChannels = atoi (argv[++i]);
+		else if ((strcmp (argv[i], "--format") == 0) && hasArg && parseSampleFormat (argv[i + 1], settings.rawFormat)) ++i;
+		else if (strcmp (argv[i], "--stream") == 0) settings.stream = true;
+		else if ((strcmp (argv[i], "--report") == 0) && hasArg) settings.reportInterval = atof (argv[++i]);
+		else if (strcmp (argv[i], "--quiet") == 0) settings.quiet = true;
+		else if ((argv[i][0] != '-') || (argv[i][1] == '\0')) files.push_back (argv[i]);
+		else
+		{
+			printUsage();
+			return (strcmp (argv[i], "--help") == 0 ? 0 : 1);
+		}
+	}
+
+	if ((files.empty() != settings.stream) || (jobs < 1) || (settings.blockSize < 1) ||
+		(settings.suffix.empty() && settings.outDir.empty()) || (settings.rawChannels < 1) || (settings.rawChannels > 2) ||
+		(settings.rawRate == 0))
+	{
+		printUsage();
+		return 1;
+	}
+
+	std::string error;
+	if (presetFile && !loadPreset (presetFile, settings.preset, error))
+	{
+		fprintf (stderr, "%s: %s.\n", presetFile, error.c_str());
+		return 1;
+	}
+	for (const std::pair<int, float>& s : sets) settings.preset.controllers[s.first] = s.second;
+	if (cursor.hasXCursor) settings.preset.setXCursor (cursor.xcursor);
+	if (cursor.hasYCursor) settings.preset.setYCursor (cursor.ycursor);
+
+	if (settings.stream) return stream (settings);
+
+	// Worker pool: Each worker takes the next file until all are done
+	std::atomic<size_t> next (0);
+	std::mutex printMutex;
+	bool failed = false;
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+	double audioSeconds = 0.0;
+
+	std::vector<std::thread> workers;
+	for (unsigned int j = 0; j < std::min<size_t> (jobs, files.size()); ++j)
+	{
+		workers.emplace_back
+		(
+			[&] ()
+			{
+				for (size_t i = next++; i < files.size(); i = next++)
+				{
+					const RenderResult r = render (files[i], settings);
+					std::lock_guard<std::mutex> lock (printMutex);
+					if (r.ok)
+					{
+						audioSeconds += r.audioSeconds;
+						if (!settings.quiet) printf ("%s -> %s: %.1f s audio in %.2f s (%.1fx realtime)\n", files[i].c_str(), r.output.c_str(), r.audioSeconds, r.seconds, (r.seconds > 0.0 ? r.audioSeconds / r.seconds : 0.0));
+					}
+					else
+					{
+						fprintf (stderr, "%s: %s.\n", files[i].c_str(), r.error.c_str());
+						failed = true;
+					}
+					fflush (stdout);
+				}
+			}
+		);
+	}
+	for (std::thread& w : workers) w.join();
+
+	const double seconds = std::chrono::duration<double> (std::chrono::steady_clock::now() - t0).count();
+	if (!settings.quiet) printf ("%lu files, %.1f s audio in %.2f s with %lu threads\n", (unsigned long) files.size(), audioSeconds, seconds, (unsigned long) workers.size());
+	return (failed ? 1 : 0);
+}
@@ -0,0 +1,240 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+/*
+ * Reader for the per-stage trace buffers of B.Angr instances built with
+ * TRACE=1. Collects the per-block stage times of one instance and dumps
+ * per-stage statistics and histograms (ticks per sample, log2 bins).
+ *
+ * Usage: bangr-trace [NAME] [--seconds S]
+ * Without NAME, the available trace buffers are listed. If there is only
+ * one, it is used.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cerrno>
+#include <csignal>
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "Trace.hpp"
+#include "../bench/Percentile.hpp"
+
+#define TRACE_BINS 32
+
+struct StageData
+{
+	std::vector<double> ticksPerSample;
+	uint64_t bins[TRACE_BINS];
+};
+
+static std::vector<std::string> listBuffers ()
+{
+	std::vector<std::string> names;
+	DIR* dir = opendir ("/dev/shm");
+	if (!dir) return names;
+
+	const std::string prefix = std::string (BANGR_TRACE_SHM_PREFIX).substr (1);
+	while (struct dirent* entry = readdir (dir))
+	{
+		if (strncmp (entry->d_name, prefix.c_str(), prefix.size()) != 0) continue;
+
+		// Skip stale buffers of terminated processes
+		const pid_t pid = atoi (entry->d_name + prefix.size());
+		if ((pid > 0) && (kill (pid, 0) != 0) && (errno == ESRCH)) continue;
+		names.push_back (std::string ("/") + entry->d_name);
+	}
+	closedir (dir);
+	std::sort (names.begin(), names.end());
+	return names;
+}
+
+static void printUsage ()
+{
+	fprintf
+	(
+		stderr,
+		"Usage: bangr-trace [NAME] [OPTIONS]\n"
+		"  --seconds S   Collection time (default 5)\n"
+		"  --help        Show this help\n"
+	);
+}
+
+int main (int argc, char** argv)
+{
+	std::string name;
+	double seconds = 5.0;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		if ((strcmp (argv[i], "--seconds") == 0) && (i + 1 < argc)) seconds = atof (argv[++i]);
+		else if ((argv[i][0] != '-') && name.empty()) name = (argv[i][0] == '/' ? "" : "/") + std::string (argv[i]);
+		else
+		{
+			printUsage();
+			return (strcmp (argv[i], "--help") == 0 ? 0 : 1);
+		}
+	}
+
+	if (name.empty())
+	{
+		const std::vector<std::string> names = listBuffers();
+		if (names.size() != 1)
+		{
+			if (names.empty()) fprintf (stderr, "No trace buffers found. Build B.Angr with TRACE=1.\n");
+			else for (const std::string& n : names) printf ("%s\n", n.c_str());
+			return (names.empty() ? 1 : 0);
+		}
+		name = names.front();
+	}
+
+	const int fd = shm_open (name.c_str(), O_RDONLY, 0);
+	if (fd < 0)
+	{
+		fprintf (stderr, "Can't open trace buffer %s.\n", name.c_str());
+		return 1;
+	}
+	void* ptr = mmap (nullptr, sizeof (TraceBuffer), PROT_READ, MAP_SHARED, fd, 0);
+	close (fd);
+	if (ptr == MAP_FAILED)
+	{
+		fprintf (stderr, "Can't map trace buffer %s.\n", name.c_str());
+		return 1;
+	}
+
+	const TraceBuffer* buffer = static_cast<const TraceBuffer*> (ptr);
+	if ((buffer->magic != BANGR_TRACE_MAGIC) || (buffer->version != BANGR_TRACE_VERSION) ||
+		(buffer->nrStages != NR_TRACE_STAGES) || (buffer->size != BANGR_TRACE_SIZE))
+	{
+		fprintf (stderr, "Incompatible trace buffer %s.\n", name.c_str());
+		return 1;
+	}
+
+	// Collect records
+	StageData stages[NR_TRACE_STAGES + 1];
+	for (StageData& s : stages) memset (s.bins, 0, sizeof (s.bins));
+	uint64_t readCount = buffer->writeCount.load (std::memory_order_acquire);
+	uint64_t blocks = 0;
+	uint64_t lost = 0;
+	const std::chrono::steady_clock::time_point t0 = std::chrono::steady_clock::now();
+
+	while (std::chrono::duration<double> (std::chrono::steady_clock::now() - t0).count() < seconds)
+	{
+		const uint64_t writeCount = buffer->writeCount.load (std::memory_order_acquire);
+		if (writeCount - readCount > BANGR_TRACE_SIZE)
+		{
+			lost += writeCount - readCount - BANGR_TRACE_SIZE;
+			readCount = writeCount - BANGR_TRACE_SIZE;
+		}
+
+		for (; readCount < writeCount; ++readCount)
+		{
+			const TraceRecord& r = buffer->records[readCount & (BANGR_TRACE_SIZE - 1)];
+			const uint64_t seq = r.seq.load (std::memory_order_acquire);
+			const uint32_t frames = r.frames;
+			uint64_t ticks[NR_TRACE_STAGES];
+			memcpy (ticks, r.ticks, sizeof (ticks));
+			std::atomic_thread_fence (std::memory_order_acquire);
+			if ((seq != readCount + 1) || (r.seq.load (std::memory_order_relaxed) != seq) || (frames == 0))
+			{
+				++lost;
+				continue;
+			}
+
+			uint64_t total = 0;
+			for (int s = 0; s <= NR_TRACE_STAGES; ++s)
+			{
+				const uint64_t t = (s < NR_TRACE_STAGES ? ticks[s] : total);
+				total += (s < NR_TRACE_STAGES ? t : 0);
+				const double tps = double (t) / frames;
+				stages[s].ticksPerSample.push_back (tps);
+				const int bin = (tps < 1.0 ? 0 : std::min<int> (TRACE_BINS - 1, 1 + int (log2 (tps))));
+				++stages[s].bins[bin];
+			}
+			++blocks;
+		}
+
+		std::this_thread::sleep_for (std::chrono::milliseconds (10));
+	}
+
+	// Calibrate ticks against the steady clock since buffer creation
+	const double rate = buffer->rate;
+	const uint32_t interval = buffer->interval;
+	const double ticksPerSecond = double (traceClock() - buffer->startTicks) / (1e-9 * double (traceTime() - buffer->startTime));
+	munmap (ptr, sizeof (TraceBuffer));
+
+	printf
+	(
+		"Trace buffer %s: %lu blocks (1 of %u traced), %lu lost, %.0f Hz, %.3f GHz ticks\n\n",
+		name.c_str(), (unsigned long) blocks, interval, (unsigned long) lost, rate, ticksPerSecond * 1e-9
+	);
+	if (blocks == 0) return 0;
+
+	printf ("%-13s %12s %12s %12s %12s %10s %10s\n", "stage", "mean tck/smp", "p50", "p99", "max", "mean %bud", "max %bud");
+	for (int s = 0; s <= NR_TRACE_STAGES; ++s)
+	{
+		StageData& d = stages[s];
+		double mean = 0.0;
+		for (double t : d.ticksPerSample) mean += t;
+		mean /= blocks;
+		const double max = *std::max_element (d.ticksPerSample.begin(), d.ticksPerSample.end());
+
+		// Share of the real-time budget (ticks per sample period)
+		const double budget = ticksPerSecond / rate;
+		printf
+		(
+			"%-13s %12.1f %12.1f %12.1f %12.1f %10.3f %10.3f\n",
+			(s < NR_TRACE_STAGES ? traceStageNames[s] : "total"),
+			mean,
+			percentile (d.ticksPerSample, 0.5),
+			percentile (d.ticksPerSample, 0.99),
+			max,
+			100.0 * mean / budget,
+			100.0 * max / budget
+		);
+	}
+
+	printf ("\nHistograms (ticks per sample)\n");
+	for (int s = 0; s <= NR_TRACE_STAGES; ++s)
+	{
+		const StageData& d = stages[s];
+		const uint64_t peak = *std::max_element (d.bins, d.bins + TRACE_BINS);
+		printf ("%s\n", (s < NR_TRACE_STAGES ? traceStageNames[s] : "total"));
+		for (int b = 0; b < TRACE_BINS; ++b)
+		{
+			if (!d.bins[b]) continue;
+			const int width = (peak ? int (50 * d.bins[b] / peak) : 0);
+			printf ("  [%10.0f, %10.0f) %-50s %lu\n", (b ? pow (2.0, b - 1) : 0.0), pow (2.0, b), std::string (width, '#').c_str(), (unsigned long) d.bins[b]);
+		}
+	}
+
+	return 0;
+}
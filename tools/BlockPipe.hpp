@@ -0,0 +1,133 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef BLOCKPIPE_HPP_
+#define BLOCKPIPE_HPP_
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+PCM block passed between the threads of the streaming mode.
+ */
+struct StreamBlock
+{
+	std::vector<uint8_t> pcm;
+	uint32_t frames = 0;
+	bool last = false;
+	std::chrono::steady_clock::time_point time;
+};
+
+/**
+Blocking single producer / single consumer queue of N preallocated
+blocks (N = 2: double buffer). The producer fills the block returned by
+beginPush() and hands it over with endPush(), the consumer processes the
+block returned by beginPop() and releases it with endPop(). Blocks are
+never allocated after construction.
+@tparam N	Number of blocks.
+ */
+template <size_t N>
+class BlockPipe
+{
+public:
+	/**
+	@param size	Size of each block in bytes.
+	 */
+	BlockPipe (const size_t size) :
+		head (0),
+		tail (0),
+		count (0),
+		aborted (false)
+	{
+		for (StreamBlock& b : blocks) b.pcm.resize (size);
+	}
+
+	BlockPipe (const BlockPipe& that) = delete;
+	BlockPipe& operator= (const BlockPipe& that) = delete;
+
+	/**
+	Waits for a free block. Called by the producer.
+	@return		Free block or nullptr if aborted.
+	 */
+	StreamBlock* beginPush ()
+	{
+		std::unique_lock<std::mutex> lock (mutex);
+		cv.wait (lock, [this] () {return (count < N) || aborted;});
+		return (aborted ? nullptr : &blocks[head]);
+	}
+
+	void endPush ()
+	{
+		{
+			std::lock_guard<std::mutex> lock (mutex);
+			head = (head + 1) % N;
+			++count;
+		}
+		cv.notify_all();
+	}
+
+	/**
+	Waits for a filled block. Called by the consumer.
+	@return		Filled block or nullptr if aborted.
+	 */
+	StreamBlock* beginPop ()
+	{
+		std::unique_lock<std::mutex> lock (mutex);
+		cv.wait (lock, [this] () {return (count > 0) || aborted;});
+		return (aborted ? nullptr : &blocks[tail]);
+	}
+
+	void endPop ()
+	{
+		{
+			std::lock_guard<std::mutex> lock (mutex);
+			tail = (tail + 1) % N;
+			--count;
+		}
+		cv.notify_all();
+	}
+
+	/**
+	Wakes up and stops both sides, e.g. on write errors.
+	 */
+	void abort ()
+	{
+		{
+			std::lock_guard<std::mutex> lock (mutex);
+			aborted = true;
+		}
+		cv.notify_all();
+	}
+
+private:
+	std::array<StreamBlock, N> blocks;
+	size_t head;
+	size_t tail;
+	size_t count;
+	bool aborted;
+	std::mutex mutex;
+	std::condition_variable cv;
+};
+
+#endif /* BLOCKPIPE_HPP_ */
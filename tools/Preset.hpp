@@ -0,0 +1,219 @@
+/* B.Angr
+ * Dynamic distorted bandpass filter plugin
+ *
+ * Copyright (C) 2026 by Sven Jähnichen
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 3, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software Foundation,
+ * Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+ */
+
+#ifndef PRESET_HPP_
+#define PRESET_HPP_
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include "ControllerLimits.hpp"
+#include "Ports.hpp"
+
+/**
+Controller values and the optional initial cursor position of a preset.
+Flags are used instead of NaN as the tools are built with -ffast-math.
+ */
+struct Preset
+{
+	float controllers[NR_CONTROLLERS];
+	float xcursor;
+	float ycursor;
+	bool hasXCursor;
+	bool hasYCursor;
+
+	Preset () :
+		controllers {0.0f},
+		xcursor (0.5f),
+		ycursor (0.5f),
+		hasXCursor (false),
+		hasYCursor (false)
+	{
+		for (int i = 0; i < NR_CONTROLLERS; ++i) controllers[i] = controllerDefaults[i];
+	}
+
+	void setXCursor (const float value)
+	{
+		xcursor = value;
+		hasXCursor = true;
+	}
+
+	void setYCursor (const float value)
+	{
+		ycursor = value;
+		hasYCursor = true;
+	}
+};
+
+/**
+Gets the controller index of a port symbol.
+@param symbol	Port symbol.
+@param length	Length of the symbol.
+@return		Controller index or -1 if not found.
+ */
+inline int findControllerSymbol (const char* symbol, const size_t length)
+{
+	for (int i = 0; i < NR_CONTROLLERS; ++i)
+	{
+		if ((strlen (controllerSymbols[i]) == length) && (strncmp (controllerSymbols[i], symbol, length) == 0)) return i;
+	}
+	return -1;
+}
+
+/**
+Parses a flat JSON object of port symbols (and optionally "xcursor" and
+"ycursor") with numeric values, e.g. {"speed": 0.5, "fx1_gain": 0.3}.
+Unknown keys are ignored.
+ */
+inline bool parseJsonPreset (const std::string& text, Preset& preset, std::string& error)
+{
+	size_t pos = text.find ('{');
+	if (pos == std::string::npos)
+	{
+		error = "No JSON object";
+		return false;
+	}
+
+	while (true)
+	{
+		const size_t keyStart = text.find ('"', pos);
+		if (keyStart == std::string::npos) break;
+		const size_t keyEnd = text.find ('"', keyStart + 1);
+		const size_t colon = (keyEnd == std::string::npos ? keyEnd : text.find (':', keyEnd));
+		if (colon == std::string::npos)
+		{
+			error = "Invalid JSON object";
+			return false;
+		}
+
+		const char* valueStart = text.c_str() + colon + 1;
+		char* valueEnd;
+		const float value = strtof (valueStart, &valueEnd);
+		if (valueEnd == valueStart)
+		{
+			error = "Non-numeric value for " + text.substr (keyStart + 1, keyEnd - keyStart - 1);
+			return false;
+		}
+
+		const std::string key = text.substr (keyStart + 1, keyEnd - keyStart - 1);
+		const int index = findControllerSymbol (key.c_str(), key.size());
+		if (index >= 0) preset.controllers[index] = value;
+		else if (key == "xcursor") preset.setXCursor (value);
+		else if (key == "ycursor") preset.setYCursor (value);
+		pos = valueEnd - text.c_str();
+	}
+
+	return true;
+}
+
+/**
+Parses an LV2 preset in Turtle syntax as saved by LV2 hosts. Port values
+are taken from the lv2:port blocks (lv2:symbol, pset:value), the cursor
+position from the B.Angr state properties. This is no complete Turtle
+parser, but sufficient for host generated presets.
+ */
+inline bool parseTtlPreset (const std::string& text, Preset& preset, std::string& error)
+{
+	int count = 0;
+	size_t pos = 0;
+
+	// Port blocks
+	while ((pos = text.find ('[', pos)) != std::string::npos)
+	{
+		const size_t end = text.find (']', pos);
+		if (end == std::string::npos) break;
+		const std::string block = text.substr (pos + 1, end - pos - 1);
+		pos = end + 1;
+
+		const size_t sym = block.find ("symbol");
+		const char* token = "pset:value";
+		size_t val = block.find (token);
+		if (val == std::string::npos) val = block.find (token = "presets#value>");
+		if ((sym == std::string::npos) || (val == std::string::npos)) continue;
+
+		const size_t symStart = block.find ('"', sym);
+		const size_t symEnd = (symStart == std::string::npos ? symStart : block.find ('"', symStart + 1));
+		if (symEnd == std::string::npos) continue;
+		const int index = findControllerSymbol (block.c_str() + symStart + 1, symEnd - symStart - 1);
+		if (index < 0) continue;
+
+		const char* valueStart = block.c_str() + val + strlen (token);
+		while (*valueStart && strchr (" \t\r\n\"", *valueStart)) ++valueStart;
+		char* valueEnd;
+		const float value = strtof (valueStart, &valueEnd);
+		if (valueEnd == valueStart) continue;
+		preset.controllers[index] = value;
+		++count;
+	}
+
+	// Cursor state
+	const char* const keys[2] = {"#xcursor>", "#ycursor>"};
+	for (int i = 0; i < 2; ++i)
+	{
+		const size_t k = text.find (keys[i]);
+		if (k == std::string::npos) continue;
+		const size_t q = text.find ('"', k);
+		if (q == std::string::npos) continue;
+		char* valueEnd;
+		const float value = strtof (text.c_str() + q + 1, &valueEnd);
+		if (valueEnd == text.c_str() + q + 1) continue;
+		if (i == 0) preset.setXCursor (value);
+		else preset.setYCursor (value);
+	}
+
+	if (count == 0)
+	{
+		error = "No B.Angr port values found";
+		return false;
+	}
+	return true;
+}
+
+/**
+Loads a preset file. JSON is detected by a leading '{', otherwise the file
+is parsed as an LV2 preset in Turtle syntax.
+@param filename	Preset file.
+@param preset	Target preset. Values not contained in the file remain.
+@param error	Error message on failure.
+@return		True on success.
+ */
+inline bool loadPreset (const std::string& filename, Preset& preset, std::string& error)
+{
+	FILE* file = fopen (filename.c_str(), "r");
+	if (!file)
+	{
+		error = "Can't open preset file " + filename;
+		return false;
+	}
+
+	std::string text;
+	char buffer[4096];
+	size_t n;
+	while ((n = fread (buffer, 1, sizeof (buffer), file)) > 0) text.append (buffer, n);
+	fclose (file);
+
+	const size_t first = text.find_first_not_of (" \t\r\n");
+	if ((first != std::string::npos) && (text[first] == '{')) return parseJsonPreset (text, preset, error);
+	return parseTtlPreset (text, preset, error);
+}
+
+#endif /* PRESET_HPP_ */